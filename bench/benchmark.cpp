@@ -0,0 +1,469 @@
+/*******************************************************************************
+ * Microbenchmark Suite
+ * -------------------
+ * Repeatable measurements for the three subsystems, emitted as one JSON
+ * document on stdout so results can be diffed between releases:
+ *
+ * I. Memory Pool
+ *    - random:   random sizes, random frees from a bounded live set
+ *    - lifo:     allocate a batch, free it newest first
+ *    - fifo:     allocate a batch, free it oldest first
+ *    - prodcons: one thread allocates, another frees (CONCURRENT pool)
+ *    - random xN: N threads on one CONCURRENT pool vs. per-core shards
+ *    - random on a pool whose strategy, locking and stats are fixed at
+ *      compile time (BasicMemoryPool policy) vs. the runtime-configured one
+ *
+ * II. Device Driver
+ *    - Throughput and completion latency percentiles for 1..16 workers
+ *      and 1 or 4 submitting threads (simulated backend)
+ *
+ * III. Logger
+ *    - Lines per second, synchronous and asynchronous (lossy/blocking),
+ *      with output discarded so the sink is not the bottleneck
+ *
+ * Usage:
+ *   g++ -std=c++17 -O2 -pthread -Isrc bench/benchmark.cpp -o benchmark
+ *   ./benchmark [--quick] [--seed N] > results.json
+ *
+ * Notes:
+ * - All random streams derive from --seed (default 1), so two runs issue
+ *   the same operation sequence
+ * - Progress goes to stderr; stdout carries only the JSON
+ ******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "memory_pool.hpp"
+#include "sharded_pool.hpp"
+#include "device_driver.hpp"
+#include "logger.hpp"
+#include "ring_buffer.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+    bool quick = false;
+    uint64_t seed = 1;
+};
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/**
+ * JSON Output
+ * ----------
+ * Flat objects appended to named arrays; enough for this report
+ */
+class JsonObject {
+    std::ostringstream body;
+    bool first = true;
+
+    void key(const char* name) {
+        body << (first ? "" : ", ") << '"' << name << "\": ";
+        first = false;
+    }
+
+public:
+    JsonObject& field(const char* name, const std::string& value) {
+        key(name);
+        body << '"' << value << '"';
+        return *this;
+    }
+    JsonObject& field(const char* name, const char* value) { return field(name, std::string(value)); }
+    JsonObject& field(const char* name, double value) {
+        key(name);
+        body << value;
+        return *this;
+    }
+    JsonObject& field(const char* name, size_t value) {
+        key(name);
+        body << value;
+        return *this;
+    }
+    JsonObject& raw(const char* name, const std::string& json) {
+        key(name);
+        body << json;
+        return *this;
+    }
+    std::string str() const { return "{" + body.str() + "}"; }
+};
+
+std::string json_array(const std::vector<std::string>& items) {
+    std::string out = "[\n    ";
+    for (size_t i = 0; i < items.size(); ++i) {
+        if (i) out += ",\n    ";
+        out += items[i];
+    }
+    return out + "\n  ]";
+}
+
+/**
+ * Latency Percentiles
+ * ------------------
+ * @return: JSON object of p50/p90/p99/max in microseconds
+ */
+std::string percentiles(std::vector<double>& samples) {
+    if (samples.empty()) return "{}";
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<size_t>(q * (samples.size() - 1))]; };
+    return JsonObject()
+        .field("p50", at(0.50)).field("p90", at(0.90)).field("p99", at(0.99))
+        .field("max", samples.back()).str();
+}
+
+/**
+ * I. Memory Pool Churn
+ * -------------------
+ */
+constexpr size_t POOL_SIZE = 64 * 1024 * 1024;
+constexpr size_t MIN_REQUEST = 16;
+constexpr size_t MAX_REQUEST = 4096;
+
+// Everything the runtime Config would decide, fixed at compile time
+struct StaticSegregatedPolicy : DefaultPoolPolicy {
+    static constexpr std::optional<Strategy> strategy = Strategy::SEGREGATED_FIT;
+    static constexpr std::optional<Concurrency> concurrency = Concurrency::SINGLE_THREADED;
+    static constexpr bool collect_stats = false;
+};
+
+struct ChurnResult {
+    size_t ops = 0;
+    size_t failures = 0;
+    double seconds = 0;
+};
+
+template <typename Pool>
+ChurnResult churn_random(Pool& pool, size_t ops, std::mt19937_64& rng) {
+    constexpr size_t LIVE_LIMIT = 4096;
+    std::uniform_int_distribution<size_t> size_dist(MIN_REQUEST, MAX_REQUEST);
+    std::vector<void*> live;
+    live.reserve(LIVE_LIMIT);
+    ChurnResult result;
+
+    auto start = Clock::now();
+    for (size_t i = 0; i < ops; ++i) {
+        bool free_one = !live.empty() && (live.size() == LIVE_LIMIT || (rng() & 1));
+        if (free_one) {
+            size_t victim = rng() % live.size();
+            pool.deallocate(live[victim]);
+            live[victim] = live.back();
+            live.pop_back();
+        } else {
+            try {
+                live.push_back(pool.allocate(size_dist(rng)));
+            } catch (const std::bad_alloc&) {
+                ++result.failures;
+            }
+        }
+    }
+    result.seconds = seconds_since(start);
+    result.ops = ops;
+    for (void* ptr : live) pool.deallocate(ptr);
+    return result;
+}
+
+ChurnResult churn_batch(MemoryPool& pool, size_t ops, std::mt19937_64& rng, bool lifo) {
+    constexpr size_t BATCH = 1024;
+    std::uniform_int_distribution<size_t> size_dist(MIN_REQUEST, MAX_REQUEST);
+    std::vector<void*> batch(BATCH);
+    ChurnResult result;
+
+    auto start = Clock::now();
+    for (size_t done = 0; done < ops; done += 2 * BATCH) {
+        size_t filled = 0;
+        for (; filled < BATCH; ++filled) {
+            try {
+                batch[filled] = pool.allocate(size_dist(rng));
+            } catch (const std::bad_alloc&) {
+                ++result.failures;
+                break;
+            }
+        }
+        for (size_t i = 0; i < filled; ++i) pool.deallocate(batch[lifo ? filled - 1 - i : i]);
+        result.ops += 2 * filled;
+    }
+    result.seconds = seconds_since(start);
+    return result;
+}
+
+ChurnResult churn_producer_consumer(size_t ops, uint64_t seed) {
+    MemoryPool pool(POOL_SIZE, MemoryPool::Strategy::SEGREGATED_FIT, MemoryPool::Concurrency::CONCURRENT);
+    MpmcRingBuffer<void*> handoff(1024);
+    size_t count = ops / 2;
+    std::atomic<size_t> failures{0};
+
+    auto start = Clock::now();
+    std::thread consumer([&] {
+        for (size_t freed = 0; freed < count;) {
+            if (auto ptr = handoff.try_pop()) {
+                pool.deallocate(*ptr);
+                ++freed;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+        pool.flush_thread_cache();
+    });
+
+    std::mt19937_64 rng(seed);
+    std::uniform_int_distribution<size_t> size_dist(MIN_REQUEST, MAX_REQUEST);
+    for (size_t produced = 0; produced < count;) {
+        void* ptr = nullptr;
+        try {
+            ptr = pool.allocate(size_dist(rng));
+        } catch (const std::bad_alloc&) {
+            failures.fetch_add(1, std::memory_order_relaxed);
+            std::this_thread::yield();  // Let the consumer return blocks
+            continue;
+        }
+        while (!handoff.try_push(ptr)) std::this_thread::yield();
+        ++produced;
+    }
+    consumer.join();
+    pool.flush_thread_cache();
+
+    ChurnResult result;
+    result.seconds = seconds_since(start);
+    result.ops = 2 * count;
+    result.failures = failures.load();
+    return result;
+}
+
+/**
+ * Multi-Threaded Churn
+ * -------------------
+ * `threads` random churners sharing one front end; thread t seeds with
+ * seed + t
+ */
+template <typename Pool>
+ChurnResult churn_threads(Pool& pool, size_t threads, size_t ops, uint64_t seed) {
+    std::vector<ChurnResult> results(threads);
+    std::vector<std::thread> workers;
+    auto start = Clock::now();
+    for (size_t t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            std::mt19937_64 rng(seed + t);
+            results[t] = churn_random(pool, ops / threads, rng);
+        });
+    }
+    for (auto& worker : workers) worker.join();
+
+    ChurnResult result;
+    result.seconds = seconds_since(start);
+    for (const auto& part : results) {
+        result.ops += part.ops;
+        result.failures += part.failures;
+    }
+    return result;
+}
+
+std::vector<std::string> bench_memory_pool(const Options& options) {
+    const size_t ops = options.quick ? 200000 : 2000000;
+    std::vector<std::string> rows;
+    auto row = [&](const char* strategy, const char* pattern, const ChurnResult& result) {
+        std::cerr << "memory_pool " << strategy << " " << pattern << "\n";
+        rows.push_back(JsonObject()
+            .field("strategy", strategy).field("pattern", pattern)
+            .field("ops", result.ops).field("failures", result.failures)
+            .field("seconds", result.seconds)
+            .field("ns_per_op", result.ops ? result.seconds * 1e9 / result.ops : 0.0)
+            .str());
+    };
+
+    for (auto strategy : {MemoryPool::Strategy::FIRST_FIT, MemoryPool::Strategy::SEGREGATED_FIT,
+                          MemoryPool::Strategy::BUDDY}) {
+        const char* name = MemoryPool::strategy_name(strategy);
+        {
+            MemoryPool pool(POOL_SIZE, strategy);
+            std::mt19937_64 rng(options.seed);
+            row(name, "random", churn_random(pool, ops, rng));
+        }
+        {
+            MemoryPool pool(POOL_SIZE, strategy);
+            std::mt19937_64 rng(options.seed);
+            row(name, "lifo", churn_batch(pool, ops, rng, true));
+        }
+        {
+            MemoryPool pool(POOL_SIZE, strategy);
+            std::mt19937_64 rng(options.seed);
+            row(name, "fifo", churn_batch(pool, ops, rng, false));
+        }
+    }
+    {
+        BasicMemoryPool<StaticSegregatedPolicy> pool(POOL_SIZE);
+        std::mt19937_64 rng(options.seed);
+        row("segregated-fit static", "random", churn_random(pool, ops, rng));
+    }
+    row(MemoryPool::strategy_name(MemoryPool::Strategy::SEGREGATED_FIT), "prodcons",
+        churn_producer_consumer(ops / 4, options.seed));
+
+    // One concurrent pool against per-core shards, same total work
+    for (size_t threads : {size_t(1), size_t(2), size_t(4), size_t(8)}) {
+        std::string pattern = "random x" + std::to_string(threads);
+        {
+            MemoryPool pool(POOL_SIZE, MemoryPool::Strategy::SEGREGATED_FIT, MemoryPool::Concurrency::CONCURRENT);
+            row("segregated-fit concurrent", pattern.c_str(), churn_threads(pool, threads, ops, options.seed));
+        }
+        {
+            ShardedMemoryPool pool(POOL_SIZE, ShardedMemoryPool::Placement::PER_CORE);
+            row("segregated-fit per-core", pattern.c_str(), churn_threads(pool, threads, ops, options.seed));
+        }
+    }
+    return rows;
+}
+
+/**
+ * II. Device Queue
+ * ---------------
+ * Small requests, so each command costs about COMMAND_OVERHEAD and the
+ * numbers reflect queueing and dispatch rather than simulated transfer
+ */
+std::vector<std::string> bench_device_driver(const Options& options) {
+    const size_t requests = options.quick ? 400 : 4000;
+    constexpr size_t REQUEST_SIZE = 512;
+    std::vector<std::string> rows;
+
+    for (size_t producers : {size_t(1), size_t(4)}) {
+        for (size_t workers : {size_t(1), size_t(2), size_t(4), size_t(8), size_t(16)}) {
+            std::cerr << "device_driver producers " << producers << " workers " << workers << "\n";
+            std::vector<double> latencies(requests);
+            std::atomic<size_t> completed{0};
+            std::atomic<size_t> rejected{0};
+
+            DeviceDriver driver(workers);
+            driver.start_processing();
+            auto start = Clock::now();
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < producers; ++p) {
+                threads.emplace_back([&, p] {
+                    std::mt19937_64 rng(options.seed + p);
+                    for (size_t i = p; i < requests; i += producers) {
+                        auto op = (rng() & 1) ? DeviceDriver::Opcode::READ : DeviceDriver::Opcode::WRITE;
+                        auto on_complete = [&, i](const DeviceDriver::Completion& done) {
+                            latencies[i] = std::chrono::duration<double, std::micro>(done.latency).count();
+                            completed.fetch_add(1, std::memory_order_release);
+                        };
+                        while (!driver.submit_request(op, REQUEST_SIZE, on_complete)) {
+                            rejected.fetch_add(1, std::memory_order_relaxed);
+                            std::this_thread::yield();  // Queue full: back off
+                        }
+                    }
+                });
+            }
+            for (auto& thread : threads) thread.join();
+            while (completed.load(std::memory_order_acquire) < requests) std::this_thread::yield();
+            double elapsed = seconds_since(start);
+            driver.stop();
+
+            rows.push_back(JsonObject()
+                .field("producers", producers).field("workers", workers)
+                .field("requests", requests).field("rejected_submits", rejected.load())
+                .field("seconds", elapsed).field("requests_per_sec", requests / elapsed)
+                .raw("latency_us", percentiles(latencies))
+                .str());
+        }
+    }
+    return rows;
+}
+
+/**
+ * III. Logger Throughput
+ * ---------------------
+ * std::cout is pointed at a discarding buffer for the duration
+ */
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+    std::streamsize xsputn(const char*, std::streamsize count) override { return count; }
+};
+
+std::vector<std::string> bench_logger(const Options& options) {
+    const size_t lines = options.quick ? 50000 : 500000;
+    Logger& logger = Logger::get_instance();
+    std::vector<std::string> rows;
+
+    struct Mode {
+        const char* name;
+        bool async;
+        Logger::Overflow overflow;
+    };
+    const Mode modes[] = {{"sync", false, Logger::Overflow::LOSSY},
+                          {"async_lossy", true, Logger::Overflow::LOSSY},
+                          {"async_blocking", true, Logger::Overflow::BLOCKING}};
+
+    NullBuffer sink;
+    std::streambuf* original = std::cout.rdbuf(&sink);
+    for (const Mode& mode : modes) {
+        for (size_t threads : {size_t(1), size_t(4)}) {
+            std::cerr << "logger " << mode.name << " threads " << threads << "\n";
+            size_t dropped_before = logger.dropped();
+            if (mode.async) logger.start_async(mode.overflow);
+            auto start = Clock::now();
+            std::vector<std::thread> workers;
+            for (size_t t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t] {
+                    for (size_t i = 0; i < lines / threads; ++i) {
+                        LOG_INFO(logger, "bench thread {} line {} value {}", t, i, 0.5 * i);
+                    }
+                });
+            }
+            for (auto& worker : workers) worker.join();
+            logger.stop_async();  // Written means written: include the drain
+            double elapsed = seconds_since(start);
+
+            size_t attempted = (lines / threads) * threads;
+            size_t dropped = logger.dropped() - dropped_before;
+            rows.push_back(JsonObject()
+                .field("mode", mode.name).field("threads", threads)
+                .field("lines", attempted).field("dropped", dropped)
+                .field("seconds", elapsed)
+                .field("calls_per_sec", attempted / elapsed)
+                .field("lines_per_sec", (attempted - dropped) / elapsed)
+                .str());
+        }
+    }
+    std::cout.rdbuf(original);
+    return rows;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--quick") == 0) {
+            options.quick = true;
+        } else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            options.seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--quick] [--seed N]\n";
+            return 1;
+        }
+    }
+
+    auto memory = bench_memory_pool(options);
+    auto device = bench_device_driver(options);
+    auto logging = bench_logger(options);
+
+    std::cout << "{\n"
+              << "  \"seed\": " << options.seed << ",\n"
+              << "  \"quick\": " << (options.quick ? "true" : "false") << ",\n"
+              << "  \"hardware_threads\": " << std::thread::hardware_concurrency() << ",\n"
+              << "  \"memory_pool\": " << json_array(memory) << ",\n"
+              << "  \"device_driver\": " << json_array(device) << ",\n"
+              << "  \"logger\": " << json_array(logging) << "\n"
+              << "}\n";
+    return 0;
+}
@@ -0,0 +1,270 @@
+/*******************************************************************************
+ * Backing Store Implementation
+ * --------------------------
+ * Obtains the raw memory behind a MemoryPool from the operating system,
+ * the way a kernel's page allocator sits beneath its object allocators:
+ *
+ * Key OS Memory Management Concepts Demonstrated:
+ * 1. Page-Granular Memory
+ *    - Page-aligned regions, sized in whole pages
+ *    - Demand paging: mmap'd pages are faulted in on first touch
+ *
+ * 2. TLB Reach
+ *    - Explicit huge pages (MAP_HUGETLB) from the reserved hugetlb pool
+ *    - Transparent huge pages via madvise(MADV_HUGEPAGE) on a 2MB-aligned range
+ *
+ * 3. Reserve and Commit
+ *    - A growable store reserves a large PROT_NONE range up front and
+ *      commits it (mprotect read/write) as the pool grows
+ *    - release_pages() hands idle pages back with madvise(MADV_DONTNEED);
+ *      the range stays mapped and refaults as zero pages on next touch
+ *
+ * 4. NUMA Placement
+ *    - Optional mbind(MPOL_BIND) of the whole region to one node
+ *    - numa_node_count() reads the online node list from sysfs
+ *
+ * Implementation Notes:
+ * - HEAP uses page-aligned operator new; all others use anonymous mmap
+ * - HUGE_PAGES falls back to TRANSPARENT_HUGE_PAGES when the hugetlb pool
+ *   is empty; active_backing() reports what was actually obtained
+ * - mbind is issued through syscall() so no libnuma dependency is needed
+ * - A reservation needs a lazily committed mapping: HEAP becomes MMAP and
+ *   HUGE_PAGES becomes TRANSPARENT_HUGE_PAGES
+ * - Commit and release granules are whole pages, 2MB for huge pages, so
+ *   a transparent huge page is never split by a partial release
+ *
+ * Error Handling:
+ * - Mapping failure: std::bad_alloc
+ * - Commit beyond the reservation or refused by the kernel: commit()
+ *   returns false
+ * - NUMA binding failure: std::system_error
+ ******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cerrno>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <new>
+#include <system_error>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+class BackingStore {
+public:
+    /**
+     * Backing Selection
+     * ----------------
+     * - HEAP:                   Page-aligned operator new (default)
+     * - MMAP:                   Anonymous mapping, faulted in lazily
+     * - HUGE_PAGES:             MAP_HUGETLB mapping of 2MB pages
+     * - TRANSPARENT_HUGE_PAGES: 2MB-aligned mapping advised MADV_HUGEPAGE
+     */
+    enum class Backing {
+        HEAP,
+        MMAP,
+        HUGE_PAGES,
+        TRANSPARENT_HUGE_PAGES
+    };
+
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+private:
+    static constexpr int MPOL_BIND_POLICY = 2;   // MPOL_BIND from <linux/mempolicy.h>
+
+    char* base;                 // Start of usable region
+    size_t length;              // Committed (usable) region size in bytes
+    size_t reserved;            // Mapped address range in bytes, >= length
+    size_t alignment;           // Guaranteed alignment of base
+    Backing backing;            // Backing actually obtained
+    int node;                   // Bound NUMA node, or -1
+
+    static size_t page_size() {
+        static const size_t size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return size;
+    }
+
+    static size_t round_up(size_t value, size_t granule) {
+        return (value + granule - 1) / granule * granule;
+    }
+
+    /**
+     * Anonymous Mapping
+     * ----------------
+     * Over-maps by `align` and trims both ends so the result is aligned
+     */
+    static char* map_aligned(size_t size, size_t align, int extra_flags, int prot = PROT_READ | PROT_WRITE) {
+        size_t span = size + (align > page_size() ? align : 0);
+        void* raw = mmap(nullptr, span, prot, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+        if (raw == MAP_FAILED) return nullptr;
+
+        uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+        uintptr_t aligned = (start + align - 1) & ~(uintptr_t(align) - 1);
+        if (aligned > start) munmap(raw, aligned - start);
+        uintptr_t end = start + span, used_end = aligned + size;
+        if (end > used_end) munmap(reinterpret_cast<void*>(used_end), end - used_end);
+        return reinterpret_cast<char*>(aligned);
+    }
+
+    void bind_to_node(int numa_node) {
+        unsigned long mask = 1UL << numa_node;
+        long rc = syscall(SYS_mbind, base, reserved, MPOL_BIND_POLICY, &mask,
+                          sizeof(mask) * 8, 0);
+        if (rc != 0) {
+            int err = errno;
+            release();
+            throw std::system_error(err, std::generic_category(), "mbind to NUMA node failed");
+        }
+        node = numa_node;
+    }
+
+    void release() {
+        if (!base) return;
+        if (backing == Backing::HEAP) ::operator delete(base, std::align_val_t(alignment));
+        else munmap(base, reserved);
+        base = nullptr;
+    }
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param size: Minimum region size; rounded up to the page granule
+     * @param requested: Preferred backing
+     * @param numa_node: Node to bind to, or -1 for the default policy
+     * @param reserve: Address range to reserve for growth; no larger than
+     *                 `size` means a fixed region
+     * @throws: std::bad_alloc, std::system_error (NUMA binding)
+     */
+    BackingStore(size_t size, Backing requested = Backing::HEAP, int numa_node = -1, size_t reserve = 0)
+        : base(nullptr), length(0), reserved(0), alignment(page_size()), backing(requested), node(-1) {
+        if (numa_node >= static_cast<int>(sizeof(unsigned long) * 8)) {
+            throw std::system_error(EINVAL, std::generic_category(), "NUMA node out of range");
+        }
+
+        if (reserve > size) {
+            if (backing == Backing::HEAP) backing = Backing::MMAP;
+            if (backing == Backing::HUGE_PAGES) backing = Backing::TRANSPARENT_HUGE_PAGES;
+            alignment = granule();
+            reserved = round_up(reserve, alignment);
+            base = map_aligned(reserved, alignment, MAP_NORESERVE, PROT_NONE);
+            if (!base) throw std::bad_alloc();
+            if (backing == Backing::TRANSPARENT_HUGE_PAGES) madvise(base, reserved, MADV_HUGEPAGE);
+            if (!commit(size)) {
+                munmap(base, reserved);
+                throw std::bad_alloc();
+            }
+            if (numa_node >= 0) bind_to_node(numa_node);
+            return;
+        }
+
+        if (backing == Backing::HUGE_PAGES) {
+            length = round_up(size, HUGE_PAGE_SIZE);
+            alignment = HUGE_PAGE_SIZE;
+            base = map_aligned(length, HUGE_PAGE_SIZE, MAP_HUGETLB);
+            if (!base) backing = Backing::TRANSPARENT_HUGE_PAGES;
+        }
+
+        if (backing == Backing::TRANSPARENT_HUGE_PAGES) {
+            length = round_up(size, HUGE_PAGE_SIZE);
+            alignment = HUGE_PAGE_SIZE;
+            base = map_aligned(length, HUGE_PAGE_SIZE, 0);
+            if (base) madvise(base, length, MADV_HUGEPAGE);
+        } else if (backing == Backing::MMAP) {
+            length = round_up(size, page_size());
+            base = map_aligned(length, page_size(), 0);
+        } else if (backing == Backing::HEAP) {
+            length = round_up(size, page_size());
+            base = static_cast<char*>(::operator new(length, std::align_val_t(alignment)));
+        }
+
+        if (!base) throw std::bad_alloc();
+        reserved = length;
+        if (numa_node >= 0) bind_to_node(numa_node);
+    }
+
+    BackingStore(const BackingStore&) = delete;
+    BackingStore& operator=(const BackingStore&) = delete;
+
+    ~BackingStore() {
+        release();
+    }
+
+    /**
+     * Commit
+     * -----
+     * Makes the first `bytes` of the reservation (rounded up to the
+     * granule) readable and writable; pages are still faulted in lazily
+     * @return: False if that exceeds the reservation or mprotect fails
+     */
+    bool commit(size_t bytes) {
+        size_t target = round_up(bytes, granule());
+        if (target <= length) return true;
+        if (target > reserved) return false;
+        if (mprotect(base + length, target - length, PROT_READ | PROT_WRITE) != 0) return false;
+        length = target;
+        return true;
+    }
+
+    /**
+     * Page Release
+     * -----------
+     * Drops the whole granules inside [from, to) with MADV_DONTNEED; their
+     * contents read back as zeros
+     * @return: Bytes released
+     */
+    size_t release_pages(char* from, char* to) {
+        size_t page = granule();
+        uintptr_t low = round_up(reinterpret_cast<uintptr_t>(from), page);
+        uintptr_t high = reinterpret_cast<uintptr_t>(to) / page * page;
+        if (high <= low) return 0;
+        if (madvise(reinterpret_cast<void*>(low), high - low, MADV_DONTNEED) != 0) return 0;
+        return high - low;
+    }
+
+    /**
+     * Accessors
+     * --------
+     */
+    char* data() const { return base; }
+    size_t size() const { return length; }
+    size_t reserved_size() const { return reserved; }
+    size_t granule() const {
+        bool huge = backing == Backing::HUGE_PAGES || backing == Backing::TRANSPARENT_HUGE_PAGES;
+        return huge ? HUGE_PAGE_SIZE : page_size();
+    }
+    size_t base_alignment() const { return alignment; }
+    Backing active_backing() const { return backing; }
+    int numa_node() const { return node; }
+
+    /**
+     * NUMA Topology
+     * ------------
+     * @return: Number of node ids the kernel reports online (highest id
+     *          + 1), or 1 without NUMA support
+     */
+    static size_t numa_node_count() {
+        std::ifstream online("/sys/devices/system/node/online");
+        std::string list;
+        if (!(online >> list)) return 1;
+
+        // Range list such as "0", "0-3" or "0,2-3"; the last id is the highest
+        size_t cut = list.find_last_of(",-");
+        const char* last = list.c_str() + (cut == std::string::npos ? 0 : cut + 1);
+        unsigned long highest = std::strtoul(last, nullptr, 10);
+        return static_cast<size_t>(highest) + 1;
+    }
+
+    static const char* backing_name(Backing backing) {
+        switch (backing) {
+            case Backing::HEAP: return "heap";
+            case Backing::MMAP: return "mmap";
+            case Backing::HUGE_PAGES: return "hugetlb";
+            case Backing::TRANSPARENT_HUGE_PAGES: return "thp";
+            default: return "unknown";
+        }
+    }
+};
@@ -0,0 +1,352 @@
+/*******************************************************************************
+ * Binary Log Sink
+ * --------------
+ * High-rate structured tracing into a memory-mapped file, in the spirit of
+ * the kernel's ftrace ring and NanoLog-style deferred formatting:
+ *
+ * I. Concepts Demonstrated:
+ * 1. Deferred Formatting
+ *    - The hot path stores a static format id and the raw argument bytes;
+ *      turning them into text is left to an offline decoder
+ *      (tools/log_decode.cpp)
+ *
+ * 2. Lock-Free Append
+ *    - Writers reserve space with one fetch_add on the file cursor and
+ *      fill their record in place in the shared mapping
+ *
+ * 3. Self-Describing Stream
+ *    - Each format string is written once, as a FORMAT record, before the
+ *      first EVENT that uses it; reopening replays every known format
+ *
+ * File Layout:
+ * [FileHeader][Record][Record]...      records are 8-byte aligned
+ * Record = RecordHeader + payload
+ *   FORMAT payload: format text ("{}" placeholders, "{{" / "}}" escapes)
+ *   EVENT payload:  arg_count x (ArgType byte + value)
+ *     INT64/UINT64/DOUBLE/POINTER: 8 bytes, BOOL/CHAR: 1 byte,
+ *     STRING: uint16 length + bytes
+ *
+ * Timestamps:
+ * - steady_clock ticks (vDSO, TSC-backed on x86 Linux); the header pairs a
+ *   steady reading with a system_clock reading taken at open so the
+ *   decoder can print wall-clock time
+ *
+ * Error Handling:
+ * - open() failures: std::system_error
+ * - File full: record dropped and counted (dropped())
+ * - Crash: the file is preallocated zero-filled; decoding stops at the
+ *   first zero-sized record
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include "logger.hpp"
+
+class BinaryLog {
+public:
+    static constexpr char MAGIC[8] = {'K', 'S', 'B', 'L', 'O', 'G', '0', '1'};
+    static constexpr uint32_t VERSION = 1;
+    static constexpr size_t DEFAULT_CAPACITY = 64 * 1024 * 1024;  // Bytes mapped per file
+    static constexpr size_t MAX_STRING = 1024;   // Longer string arguments are truncated
+
+    /**
+     * On-Disk Structures
+     * -----------------
+     */
+    struct FileHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t header_size;       // sizeof(FileHeader); records start here
+        int64_t steady_origin;      // steady_clock ticks at open
+        int64_t wall_origin_ns;     // system_clock nanoseconds at open
+        int64_t ticks_per_second;   // steady_clock resolution
+    };
+
+    enum RecordType : uint8_t {
+        FORMAT = 1,
+        EVENT = 2
+    };
+
+    struct RecordHeader {
+        uint32_t size;          // Whole record incl. header and padding; 0 = end
+        uint8_t type;           // RecordType
+        uint8_t level;          // Logger::Level (EVENT)
+        uint16_t arg_count;     // Encoded arguments (EVENT)
+        uint32_t format_id;     // Format string id
+        uint32_t reserved;
+        int64_t ticks;          // steady_clock ticks (EVENT)
+    };
+
+    enum ArgType : uint8_t {
+        INT64 = 1,
+        UINT64,
+        DOUBLE,
+        BOOL,
+        CHAR,
+        STRING,
+        POINTER
+    };
+
+    static constexpr size_t align_record(size_t size) { return (size + 7) & ~size_t(7); }
+
+private:
+    std::mutex registry_mutex;          // Guards formats and open/close
+    std::vector<std::string> formats;   // Format text by id - 1
+    std::atomic<bool> open_;            // Writers may append
+    std::atomic<size_t> writers;        // Appends in progress
+    std::atomic<size_t> cursor;         // Next free byte in the mapping
+    std::atomic<size_t> dropped_count;  // Records lost to a full file
+    char* base;                         // Mapping of the whole file
+    size_t capacity_;                   // Mapped bytes
+    int fd;                             // Open log file
+
+    BinaryLog()
+        : open_(false), writers(0), cursor(0), dropped_count(0),
+          base(nullptr), capacity_(0), fd(-1) {}
+
+    ~BinaryLog() {
+        close();
+    }
+
+    /**
+     * Argument Encoding
+     * ----------------
+     */
+    template <typename T>
+    static size_t encoded_size(const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool> || std::is_same_v<U, char>) {
+            return 2;
+        } else if constexpr (std::is_arithmetic_v<U> || std::is_enum_v<U>) {
+            return 9;
+        } else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            return 3 + (value ? std::min(std::strlen(value), MAX_STRING) : 0);
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return 3 + std::min(std::string_view(value).size(), MAX_STRING);
+        } else {
+            static_assert(std::is_pointer_v<U>, "Unsupported binary log argument type");
+            return 9;
+        }
+    }
+
+    template <typename V>
+    static char* put(char* out, ArgType type, V value) {
+        *out++ = static_cast<char>(type);
+        std::memcpy(out, &value, sizeof(value));
+        return out + sizeof(value);
+    }
+
+    static char* put_string(char* out, std::string_view text) {
+        uint16_t length = static_cast<uint16_t>(std::min(text.size(), MAX_STRING));
+        *out++ = static_cast<char>(STRING);
+        std::memcpy(out, &length, sizeof(length));
+        std::memcpy(out + sizeof(length), text.data(), length);
+        return out + sizeof(length) + length;
+    }
+
+    template <typename T>
+    static char* encode(char* out, const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            return put(out, BOOL, static_cast<uint8_t>(value));
+        } else if constexpr (std::is_same_v<U, char>) {
+            return put(out, CHAR, value);
+        } else if constexpr (std::is_floating_point_v<U>) {
+            return put(out, DOUBLE, static_cast<double>(value));
+        } else if constexpr (std::is_enum_v<U>) {
+            return put(out, INT64, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>) {
+            return put(out, INT64, static_cast<int64_t>(value));
+        } else if constexpr (std::is_integral_v<U>) {
+            return put(out, UINT64, static_cast<uint64_t>(value));
+        } else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            return put_string(out, value ? std::string_view(value) : std::string_view());
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            return put_string(out, std::string_view(value));
+        } else {
+            return put(out, POINTER, static_cast<uint64_t>(reinterpret_cast<uintptr_t>(value)));
+        }
+    }
+
+    static int64_t now_ticks() {
+        return std::chrono::steady_clock::now().time_since_epoch().count();
+    }
+
+    /**
+     * Space Reservation
+     * ----------------
+     * @return: Start of `size` reserved bytes, or nullptr when full
+     */
+    char* reserve(size_t size) {
+        size_t offset = cursor.fetch_add(size, std::memory_order_relaxed);
+        if (offset + size > capacity_) {
+            dropped_count.fetch_add(1, std::memory_order_relaxed);
+            return nullptr;
+        }
+        return base + offset;
+    }
+
+    // Called with registry_mutex held
+    void write_format(uint32_t id, std::string_view text) {
+        size_t size = align_record(sizeof(RecordHeader) + text.size());
+        char* out = reserve(size);
+        if (!out) return;
+        RecordHeader header{static_cast<uint32_t>(size), FORMAT, 0, 0, id, 0, 0};
+        std::memcpy(out + sizeof(header), text.data(), text.size());
+        std::memcpy(out, &header, sizeof(header));
+    }
+
+public:
+    /**
+     * Singleton Access
+     * ---------------
+     * One process-wide sink, so format ids stay valid across reopen
+     */
+    static BinaryLog& get_instance() {
+        static BinaryLog instance;
+        return instance;
+    }
+
+    BinaryLog(const BinaryLog&) = delete;
+    BinaryLog& operator=(const BinaryLog&) = delete;
+
+    /**
+     * File Lifecycle
+     * -------------
+     * open() creates/truncates `path`, preallocates and maps `capacity`
+     * bytes; close() waits out in-flight appends, unmaps and trims the
+     * file to the bytes written.
+     * @throws std::system_error if the file cannot be created or mapped
+     */
+    void open(const std::string& path, size_t capacity = DEFAULT_CAPACITY) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        close_locked();
+
+        int file = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file < 0) throw std::system_error(errno, std::generic_category(), "open " + path);
+        if (::ftruncate(file, static_cast<off_t>(capacity)) != 0) {
+            int error = errno;
+            ::close(file);
+            throw std::system_error(error, std::generic_category(), "ftruncate " + path);
+        }
+        void* mapping = ::mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+        if (mapping == MAP_FAILED) {
+            int error = errno;
+            ::close(file);
+            throw std::system_error(error, std::generic_category(), "mmap " + path);
+        }
+
+        fd = file;
+        base = static_cast<char*>(mapping);
+        capacity_ = capacity;
+        FileHeader header{};
+        std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.version = VERSION;
+        header.header_size = sizeof(FileHeader);
+        header.steady_origin = now_ticks();
+        header.wall_origin_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        header.ticks_per_second = std::chrono::steady_clock::period::den /
+                                  std::chrono::steady_clock::period::num;
+        std::memcpy(base, &header, sizeof(header));
+        cursor.store(align_record(sizeof(FileHeader)), std::memory_order_relaxed);
+        dropped_count.store(0, std::memory_order_relaxed);
+
+        for (size_t i = 0; i < formats.size(); ++i) {
+            write_format(static_cast<uint32_t>(i + 1), formats[i]);
+        }
+        open_.store(true, std::memory_order_seq_cst);
+    }
+
+    void close() {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        close_locked();
+    }
+
+    bool is_open() const { return open_.load(std::memory_order_relaxed); }
+    size_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+
+    /**
+     * Format Registration
+     * ------------------
+     * Called once per call site (BLOG keeps the id in a static)
+     * @return: Id used by write()
+     */
+    uint32_t register_format(std::string_view text) {
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        formats.emplace_back(text);
+        uint32_t id = static_cast<uint32_t>(formats.size());
+        if (base) write_format(id, text);
+        return id;
+    }
+
+    /**
+     * Event Append
+     * -----------
+     * Lock-free; a no-op while no file is open
+     */
+    template <typename... Args>
+    void write(Logger::Level level, uint32_t format_id, const Args&... args) {
+        writers.fetch_add(1, std::memory_order_seq_cst);
+        if (open_.load(std::memory_order_seq_cst)) {
+            size_t size = align_record(sizeof(RecordHeader) + (size_t(0) + ... + encoded_size(args)));
+            if (char* out = reserve(size)) {
+                char* payload = out + sizeof(RecordHeader);
+                ((payload = encode(payload, args)), ...);
+                (void)payload;
+                RecordHeader header{static_cast<uint32_t>(size), EVENT, static_cast<uint8_t>(level),
+                                    static_cast<uint16_t>(sizeof...(Args)), format_id, 0, now_ticks()};
+                std::memcpy(out, &header, sizeof(header));
+            }
+        }
+        writers.fetch_sub(1, std::memory_order_release);
+    }
+
+private:
+    void close_locked() {
+        if (!base) return;
+        open_.store(false, std::memory_order_seq_cst);
+        while (writers.load(std::memory_order_seq_cst) != 0) std::this_thread::yield();
+
+        size_t used = std::min(cursor.load(std::memory_order_relaxed), capacity_);
+        ::munmap(base, capacity_);
+        if (::ftruncate(fd, static_cast<off_t>(used)) != 0) {
+            // Keep the zero-filled tail; the decoder stops at it
+        }
+        ::close(fd);
+        base = nullptr;
+        capacity_ = 0;
+        fd = -1;
+    }
+};
+
+/**
+ * Trace Macro
+ * ----------
+ * BLOG(Logger::Level::DEBUG, "allocate {} bytes at {}", size, ptr): one
+ * relaxed load when no file is open; otherwise registers the format once
+ * per call site and appends the raw arguments.
+ */
+#define BLOG(level, format, ...)                                                  \
+    do {                                                                          \
+        BinaryLog& blog_sink_ = BinaryLog::get_instance();                        \
+        if (blog_sink_.is_open()) {                                               \
+            static const uint32_t blog_format_id_ = blog_sink_.register_format(format); \
+            blog_sink_.write((level), blog_format_id_, ##__VA_ARGS__);            \
+        }                                                                         \
+    } while (0)
@@ -0,0 +1,330 @@
+/*******************************************************************************
+ * Buddy Allocator Engine
+ * --------------------
+ * Binary buddy system over a caller-supplied memory region, the scheme the
+ * Linux page allocator uses for physical frames:
+ *
+ * Key OS Memory Management Concepts Demonstrated:
+ * 1. Power-of-Two Block Orders
+ *    - Every block is 2^k bytes and aligned to its own size
+ *    - A block's buddy differs only in bit k of its offset
+ *
+ * 2. Split and Merge
+ *    - Allocation splits larger blocks down to the requested order
+ *    - Freeing merges with the buddy for as long as the buddy is free
+ *    - Both walk at most one step per order: O(log n)
+ *
+ * 3. Bounded Fragmentation
+ *    - Free space is always a set of maximal aligned blocks
+ *    - Internal fragmentation below 50% per block by construction
+ *
+ * Implementation Notes:
+ * - Free blocks: per-order intrusive free lists plus a per-order bitmap
+ *   (bit set = block at that order is free), so buddy lookup is one bit test
+ * - Allocated blocks: order recorded in a side table indexed by the
+ *   block's offset in MIN_BLOCK units; no in-band header, so user data
+ *   keeps the block's natural alignment
+ * - Regions that are not a power of two are carved into maximal aligned
+ *   power-of-two blocks that never merge past the region end
+ *
+ * Memory Layout (order 3 region, min order 0):
+ * +-------------------------------+
+ * |             8                 |  <- order 3
+ * +---------------+---------------+
+ * |       4       |       4       |  <- order 2
+ * +-------+-------+-------+-------+
+ * |   2   |   2   |   2   |   2   |  <- order 1
+ * +-------------------------------+
+ *
+ * Error Handling:
+ * - Out of memory: nullptr (caller decides whether to throw)
+ * - Invalid free: Silent return
+ * - Corruption: validate() throws std::logic_error
+ ******************************************************************************/
+
+#pragma once
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * BuddyAllocator Class
+ * ===================
+ * Manages [base, base + size) without owning it.
+ */
+class BuddyAllocator {
+public:
+    static constexpr size_t MIN_ORDER = 6;                     // 64-byte blocks
+    static constexpr size_t MIN_BLOCK = size_t(1) << MIN_ORDER;
+    static constexpr size_t MAX_ORDERS = sizeof(size_t) * 8;
+
+private:
+    static constexpr uint8_t NOT_ALLOCATED = 0xFF;
+
+    /**
+     * Free-List Links
+     * --------------
+     * Stored inside free blocks only
+     */
+    struct FreeLinks {
+        FreeLinks* prev;
+        FreeLinks* next;
+    };
+
+    char* base;                                      // Managed region start
+    size_t region_size;                              // Usable bytes (multiple of MIN_BLOCK)
+    size_t max_order;                                // Largest order that fits the region
+    std::array<FreeLinks*, MAX_ORDERS> free_lists;   // Free-list head per order
+    std::array<size_t, MAX_ORDERS> free_counts;      // Free blocks per order
+    std::array<std::vector<uint64_t>, MAX_ORDERS> free_bits;  // Free bitmap per order
+    uint64_t order_map;                              // Bit k set when order k has free blocks
+    std::vector<uint8_t> alloc_order;                // Order of allocated block at each MIN_BLOCK slot
+    size_t used_bytes;                               // Bytes in allocated blocks
+    size_t allocated_blocks;                         // Number of allocated blocks
+
+    /**
+     * Bitmap Helpers
+     * -------------
+     * Bit (offset >> order) of free_bits[order]
+     */
+    bool test_free(size_t order, size_t offset) const {
+        size_t index = offset >> order;
+        return (free_bits[order][index / 64] >> (index % 64)) & 1;
+    }
+
+    void set_free(size_t order, size_t offset, bool value) {
+        size_t index = offset >> order;
+        uint64_t mask = uint64_t(1) << (index % 64);
+        if (value) free_bits[order][index / 64] |= mask;
+        else free_bits[order][index / 64] &= ~mask;
+    }
+
+    /**
+     * Free-List Maintenance
+     * --------------------
+     * O(1) push/unlink keeping list, bitmap and order map in step
+     */
+    void push_free(size_t order, size_t offset) {
+        FreeLinks* node = reinterpret_cast<FreeLinks*>(base + offset);
+        node->prev = nullptr;
+        node->next = free_lists[order];
+        if (free_lists[order]) free_lists[order]->prev = node;
+        free_lists[order] = node;
+        ++free_counts[order];
+        set_free(order, offset, true);
+        order_map |= uint64_t(1) << order;
+    }
+
+    void unlink_free(size_t order, size_t offset) {
+        FreeLinks* node = reinterpret_cast<FreeLinks*>(base + offset);
+        if (node->prev) node->prev->next = node->next;
+        else free_lists[order] = node->next;
+        if (node->next) node->next->prev = node->prev;
+        --free_counts[order];
+        set_free(order, offset, false);
+        if (!free_lists[order]) order_map &= ~(uint64_t(1) << order);
+    }
+
+    size_t offset_of(const void* ptr) const {
+        return static_cast<size_t>(static_cast<const char*>(ptr) - base);
+    }
+
+public:
+    /**
+     * Order Computation
+     * ----------------
+     * Smallest order whose block holds `size` bytes
+     */
+    static size_t order_for(size_t size) {
+        size_t order = MIN_ORDER;
+        while (order < MAX_ORDERS - 1 && (size_t(1) << order) < size) ++order;
+        return order;
+    }
+
+    /**
+     * Constructor
+     * ----------
+     * @param region: Start of managed memory (MIN_BLOCK alignment recommended)
+     * @param size: Region size in bytes; rounded down to MIN_BLOCK
+     */
+    BuddyAllocator(char* region, size_t size)
+        : base(region), region_size(size & ~(MIN_BLOCK - 1)), max_order(MIN_ORDER),
+          order_map(0), used_bytes(0), allocated_blocks(0) {
+        if (region_size < MIN_BLOCK) {
+            throw std::invalid_argument("Buddy region too small for a single block");
+        }
+        while (max_order + 1 < MAX_ORDERS && (size_t(1) << (max_order + 1)) <= region_size) ++max_order;
+
+        free_lists.fill(nullptr);
+        free_counts.fill(0);
+        for (size_t order = MIN_ORDER; order <= max_order; ++order) {
+            size_t blocks = region_size >> order;
+            free_bits[order].assign(blocks / 64 + 1, 0);
+        }
+        alloc_order.assign(region_size >> MIN_ORDER, NOT_ALLOCATED);
+
+        // Carve the region into maximal aligned power-of-two blocks
+        size_t offset = 0;
+        for (size_t order = max_order + 1; order-- > MIN_ORDER;) {
+            size_t block = size_t(1) << order;
+            if (offset + block <= region_size) {
+                push_free(order, offset);
+                offset += block;
+            }
+        }
+    }
+
+    /**
+     * Block Allocation
+     * ---------------
+     * 1. Find the smallest non-empty order >= requested (bitmap scan)
+     * 2. Split down, returning each upper half to its free list
+     * @return: Block start, or nullptr when no block is large enough
+     */
+    void* allocate(size_t size) {
+        size_t order = order_for(size);
+        if (order > max_order) return nullptr;
+
+        uint64_t candidates = order_map & (~uint64_t(0) << order);
+        if (!candidates) return nullptr;
+        size_t found = order;
+        while (!(candidates & (uint64_t(1) << found))) ++found;
+
+        size_t offset = offset_of(free_lists[found]);
+        unlink_free(found, offset);
+        while (found > order) {
+            --found;
+            push_free(found, offset + (size_t(1) << found));
+        }
+
+        alloc_order[offset >> MIN_ORDER] = static_cast<uint8_t>(order);
+        used_bytes += size_t(1) << order;
+        ++allocated_blocks;
+        return base + offset;
+    }
+
+    /**
+     * Block Deallocation
+     * -----------------
+     * Merges with the buddy while the buddy is free at the same order
+     */
+    void deallocate(void* ptr) {
+        if (!owns(ptr)) return;
+
+        size_t offset = offset_of(ptr);
+        size_t order = alloc_order[offset >> MIN_ORDER];
+        alloc_order[offset >> MIN_ORDER] = NOT_ALLOCATED;
+        used_bytes -= size_t(1) << order;
+        --allocated_blocks;
+
+        while (order < max_order) {
+            size_t buddy = offset ^ (size_t(1) << order);
+            if (buddy + (size_t(1) << order) > region_size || !test_free(order, buddy)) break;
+            unlink_free(order, buddy);
+            offset &= ~(size_t(1) << order);
+            ++order;
+        }
+        push_free(order, offset);
+    }
+
+    /**
+     * Ownership and Size Queries
+     * -------------------------
+     * True only for the start of a currently allocated block
+     */
+    bool owns(const void* ptr) const {
+        const char* p = static_cast<const char*>(ptr);
+        if (p < base || p >= base + region_size) return false;
+        size_t offset = offset_of(ptr);
+        return offset % MIN_BLOCK == 0 && alloc_order[offset >> MIN_ORDER] != NOT_ALLOCATED;
+    }
+
+    size_t block_size(const void* ptr) const {
+        return size_t(1) << alloc_order[offset_of(ptr) >> MIN_ORDER];
+    }
+
+    /**
+     * Statistics Accessors
+     * -------------------
+     * largest_free_block() is O(1) via the order map
+     */
+    size_t size() const { return region_size; }
+    size_t used() const { return used_bytes; }
+    size_t min_order() const { return MIN_ORDER; }
+    size_t top_order() const { return max_order; }
+    size_t free_blocks_at(size_t order) const { return order < MAX_ORDERS ? free_counts[order] : 0; }
+
+    size_t free_block_count() const {
+        size_t blocks = 0;
+        for (size_t order = MIN_ORDER; order <= max_order; ++order) blocks += free_counts[order];
+        return blocks;
+    }
+
+    size_t block_count() const { return allocated_blocks + free_block_count(); }
+
+    size_t largest_free_block() const {
+        if (!order_map) return 0;
+        size_t order = MAX_ORDERS - 1;
+        while (!(order_map & (uint64_t(1) << order))) --order;
+        return size_t(1) << order;
+    }
+
+    /**
+     * Consistency Validation
+     * ---------------------
+     * 1. Allocated and free blocks tile the region exactly
+     * 2. Every block is aligned to its order
+     * 3. No free block has a free buddy of the same order
+     * 4. Free counts, lists and used bytes match the running totals
+     *
+     * @throws: std::logic_error describing the first violated invariant
+     */
+    void validate() const {
+        auto fail = [](const std::string& what, size_t offset) {
+            throw std::logic_error("BuddyAllocator corrupt: " + what + " at offset " +
+                                   std::to_string(offset));
+        };
+
+        std::array<size_t, MAX_ORDERS> seen_free{};
+        size_t seen_used = 0, seen_allocated = 0, offset = 0;
+        while (offset < region_size) {
+            size_t order = alloc_order[offset >> MIN_ORDER];
+            if (order != NOT_ALLOCATED) {
+                if (order < MIN_ORDER || order > max_order) fail("bad allocated order", offset);
+                seen_used += size_t(1) << order;
+                ++seen_allocated;
+            } else {
+                order = MIN_ORDER;
+                while (order <= max_order &&
+                       !((offset & ((size_t(1) << order) - 1)) == 0 && test_free(order, offset))) {
+                    ++order;
+                }
+                if (order > max_order) fail("block neither free nor allocated", offset);
+                size_t buddy = offset ^ (size_t(1) << order);
+                if (order < max_order && buddy + (size_t(1) << order) <= region_size &&
+                    test_free(order, buddy)) {
+                    fail("unmerged free buddies", offset);
+                }
+                ++seen_free[order];
+            }
+            if (offset & ((size_t(1) << order) - 1)) fail("misaligned block", offset);
+            offset += size_t(1) << order;
+        }
+
+        if (offset != region_size) fail("blocks overrun region end", offset);
+        if (seen_used != used_bytes || seen_allocated != allocated_blocks) fail("usage mismatch", 0);
+        for (size_t order = MIN_ORDER; order <= max_order; ++order) {
+            size_t listed = 0;
+            for (FreeLinks* node = free_lists[order]; node; node = node->next) {
+                if (++listed > free_counts[order]) fail("free list longer than count", offset_of(node));
+            }
+            if (listed != free_counts[order] || seen_free[order] != free_counts[order]) {
+                fail("free count mismatch at order " + std::to_string(order), 0);
+            }
+            if (((order_map >> order) & 1) != (listed > 0 ? 1u : 0u)) fail("order map mismatch", 0);
+        }
+    }
+};
@@ -5,19 +5,26 @@
  * 
  * I. Command Processing Architecture:
  * 1. Command Parser
- *    - Token separation
- *    - Argument validation
+ *    - Token separation into string_views over the input line
+ *    - Argument validation with std::from_chars (no allocation, no
+ *      exceptions)
  *    - Command recognition
  * 
  * 2. Dispatch System
- *    - Command registration
- *    - Handler mapping
+ *    - Flat command table of member-function handlers
+ *    - Perfect hash over the command names: one hash, one compare
  *    - Error propagation
  * 
- * 3. Mode Support
+ * 3. Scratch Memory
+ *    - Each command's token vector lives in a MemoryArena over the memory
+ *      pool, rewound when the command finishes
+ * 
+ * 4. Mode Support
  *    - Interactive shell
- *    - Batch processing
+ *    - Script mode: a file or piped stdin, read in SCRIPT_BLOCK-byte
+ *      blocks and run in place, with output flushed once per block
  *    - Test sequence execution
+ *    - Workload trace record and replay (see trace.hpp)
  * 
  * II. System Integration:
  * 1. Component Interaction
@@ -51,15 +58,24 @@
  ******************************************************************************/
 
 #pragma once
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstring>
 #include <string>
+#include <string_view>
+#include <system_error>
 #include <vector>
-#include <sstream>
 #include <iostream>
-#include <functional>
 #include <map>
+#include <memory>
+#include <unordered_map>
 #include "memory_pool.hpp"
+#include "memory_arena.hpp"
 #include "device_driver.hpp"
 #include "logger.hpp"
+#include "trace.hpp"
 
 /**
  * Command Line Interface (CLI) Class
@@ -89,7 +105,15 @@
  *     └──────────────── [Output/Feedback] ←─────────────┘
  */
 class CLI {
+public:
+    using Args = std::pmr::vector<std::string_view>;  // Views into the command line, vector in the scratch arena
+
 private:
+    static constexpr size_t SCRATCH_CHUNK = 1024;  // Arena chunk size; one chunk fits a typical command line
+    static constexpr size_t SCRATCH_POOL = 64 * 1024;  // Private pool behind the arena; bounds tokens per command
+    static constexpr size_t SCRIPT_BLOCK = 64 * 1024;  // Script bytes read (and output flushed) per batch
+    static constexpr size_t SUBMIT_BATCH = 32;     // Queued submits that force a batch submission
+
     /**
      * System Component References
      * -------------------------
@@ -104,81 +128,211 @@ private:
     bool running;                         // Main loop control
     bool test_mode;                       // Operation mode flag
     std::vector<std::string> test_outputs;// Test output collection
+    std::unordered_map<void*, uint64_t> live_blocks;  // Allocated block -> trace label (0 = unrecorded)
+    std::unordered_map<uint64_t, void*> labels;       // "@label" -> allocated block
+    std::unordered_map<uint64_t, std::pair<MemoryPool::Handle, uint64_t>> movable;  // "@label" -> handle, trace label
+    TraceRecorder own_recorder;           // Workload capture (trace record) for a top-level session
+    TraceRecorder& recorder;              // Recorder in use: own_recorder, or the parent's for replay sessions
+    uint32_t stream_id;                   // This session's stream in recorded traces
+    uint64_t next_trace_label;            // Label for the next recorded allocation
+    MemoryPool scratch_pool;              // Backs scratch, so parsing never touches the user's pool
+    MemoryArena scratch;                  // Per-command scratch memory
+    bool batch_submits;                   // Queue consecutive submits for one submit_batch call
+    std::vector<DeviceDriver::DeviceRequest> pending_submits;  // Submits not yet handed to the driver
 
     /**
      * Command Registry
      * ---------------
-     * Maps command names to:
+     * One flat table, sorted by name for help output. Each entry holds:
+     * - Command name
      * - Help string
-     * - Handler function
+     * - Handler member function
      */
-    std::map<std::string, std::pair<std::string, std::function<void(const std::vector<std::string>&)>>> commands;
+    using Handler = void (CLI::*)(const Args&);
+
+    struct Command {
+        std::string_view name;   // First token of the command line
+        const char* help;        // One-line usage
+        Handler handler;         // Runs with the remaining tokens
+    };
+
+    static const std::array<Command, 15>& command_table() {
+        static const std::array<Command, 15> table = {{
+            {"allocate", "Allocate memory: allocate <size> [@label [movable]]", &CLI::handle_allocate},
+            {"backend", "Select I/O backend: backend <simulated|file <path>>", &CLI::handle_backend},
+            {"binlog", "Binary event trace: binlog <path|off>", &CLI::handle_binlog},
+            {"compact", "Compact movable blocks: compact [budget_us]", &CLI::handle_compact},
+            {"exit", "Exit the program", &CLI::handle_exit},
+            {"free", "Free memory: free <address|@label>", &CLI::handle_free},
+            {"help", "Show available commands", &CLI::handle_help},
+            {"log", "Select logging mode: log <sync|async [lossy|blocking]>", &CLI::handle_log},
+            {"merge", "Toggle request merging: merge <on|off>", &CLI::handle_merge},
+            {"metrics", "Metrics snapshot: metrics [json|prometheus]", &CLI::handle_metrics},
+            {"scheduler", "Select I/O scheduler: scheduler <fifo|deadline|sjf|priority>", &CLI::handle_scheduler},
+            {"stats", "Show system statistics", &CLI::handle_stats},
+            {"submit", "Submit device request: submit <read|write> <size> [rt|be|idle] [offset]",
+             &CLI::handle_submit},
+            {"trace", "Workload trace: trace <record <path>|stop|replay <path> [fast|timed] [threads]>",
+             &CLI::handle_trace},
+            {"trim", "Return idle free pages to the OS: trim [min_idle]", &CLI::handle_trim},
+        }};
+        return table;
+    }
+
+    /**
+     * Command Lookup Index
+     * -------------------
+     * Perfect hash over the command names: the seed is searched once so
+     * that every name hashes to its own slot, so a lookup is one FNV-1a
+     * hash and one string compare. Built on first use.
+     */
+    struct CommandIndex {
+        static constexpr size_t SLOTS = 64;   // Power of two, well above the command count
+        uint32_t seed = 0;
+        std::array<uint8_t, SLOTS> slots{};   // Table index + 1, or 0 for no command
+
+        static size_t slot_of(std::string_view name, uint32_t seed) {
+            uint32_t hash = 2166136261u ^ seed;
+            for (char c : name) hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+            return hash & (SLOTS - 1);
+        }
+
+        CommandIndex() {
+            const auto& table = command_table();
+            for (;; ++seed) {
+                slots.fill(0);
+                bool collision = false;
+                for (size_t i = 0; i < table.size() && !collision; ++i) {
+                    uint8_t& slot = slots[slot_of(table[i].name, seed)];
+                    collision = slot != 0;
+                    slot = static_cast<uint8_t>(i + 1);
+                }
+                if (!collision) return;
+            }
+        }
+
+        const Command* find(std::string_view name) const {
+            uint8_t slot = slots[slot_of(name, seed)];
+            if (!slot) return nullptr;
+            const Command& command = command_table()[slot - 1];
+            return command.name == name ? &command : nullptr;
+        }
+    };
+
+    static const CommandIndex& command_index() {
+        static const CommandIndex index;
+        return index;
+    }
 
     /**
      * Command Parsing
      * --------------
-     * Splits command string into tokens
+     * Splits the line on whitespace without copying: returns the command
+     * name and appends the remaining tokens to `args`, all views into
+     * `input`
      */
-    std::vector<std::string> split_command(const std::string& input) {
-        std::vector<std::string> tokens;
-        std::stringstream ss(input);
-        std::string token;
-
-        while (ss >> token) {
-            tokens.push_back(token);
+    static std::string_view split_command(std::string_view input, Args& args) {
+        auto is_space = [](char c) { return c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f'; };
+        std::string_view name;
+        size_t pos = 0;
+        while (pos < input.size()) {
+            while (pos < input.size() && is_space(input[pos])) ++pos;
+            size_t start = pos;
+            while (pos < input.size() && !is_space(input[pos])) ++pos;
+            if (pos == start) break;
+            std::string_view token = input.substr(start, pos - start);
+            if (name.empty()) name = token;
+            else args.push_back(token);
         }
+        return name;
+    }
 
-        return tokens;
+    /**
+     * Number Parsing
+     * -------------
+     * Whole-token decimal parse with std::from_chars
+     * @return: False unless all of `text` is a number that fits T
+     */
+    template <typename T>
+    static bool parse_number(std::string_view text, T& value) {
+        const char* end = text.data() + text.size();
+        auto result = std::from_chars(text.data(), end, value);
+        return result.ec == std::errc() && result.ptr == end;
     }
 
 public:
     /**
      * Constructor: System Integration
      * -----------------------------
-     * Initializes CLI and registers all available commands
+     * Initializes CLI state; the command table is static
      */
     CLI(MemoryPool& mp, DeviceDriver& dd, bool is_test = false)
         : memory_pool(mp), device_driver(dd), 
-          logger(Logger::get_instance()), running(true), test_mode(is_test) {
-
-        // Register available commands
-        commands["help"] = {"Show available commands", 
-            [this](const std::vector<std::string>&) { show_help(); }};
-
-        commands["allocate"] = {"Allocate memory: allocate <size>",
-            [this](const std::vector<std::string>& args) { handle_allocate(args); }};
+          logger(Logger::get_instance()), running(true), test_mode(is_test),
+          recorder(own_recorder), stream_id(new_stream_id()), next_trace_label(1),
+          scratch_pool(SCRATCH_POOL), scratch(scratch_pool, SCRATCH_CHUNK), batch_submits(false) {
+    }
 
-        commands["submit"] = {"Submit device request: submit <operation> <size>",
-            [this](const std::vector<std::string>& args) { handle_submit(args); }};
+    /**
+     * Destructor: Session Teardown
+     * ---------------------------
+     * Hands any queued submits to the driver and returns every block the
+     * session still holds to the pool, so a session (e.g. one replayed
+     * trace stream) never leaks into a pool that outlives it
+     */
+    ~CLI() {
+        flush_submits();
+        for (auto& block : live_blocks) memory_pool.deallocate(block.first);
+        for (auto& block : movable) memory_pool.deallocate(block.second.first);
+    }
 
-        commands["stats"] = {"Show system statistics",
-            [this](const std::vector<std::string>&) { show_stats(); }};
+    CLI(const CLI&) = delete;
+    CLI& operator=(const CLI&) = delete;
 
-        commands["exit"] = {"Exit the program",
-            [this](const std::vector<std::string>&) { running = false; }};
+    /**
+     * Submit Batching
+     * --------------
+     * While enabled, consecutive submit commands are queued and handed to
+     * the driver with one submit_batch() call when any other command
+     * arrives, SUBMIT_BATCH are queued, or the session ends. Used by fast
+     * trace replay, where a stream's bursts of submits need not be issued
+     * one at a time.
+     */
+    void set_batch_submits(bool enable) {
+        if (!enable) flush_submits();
+        batch_submits = enable;
     }
 
     /**
      * Command Execution
      * ----------------
-     * Processes a single command with error handling
+     * Processes a single command with error handling; `input` only needs
+     * to outlive the call. Tokens live in the session's own scratch pool,
+     * so a full memory pool cannot break parsing; a command with more
+     * tokens than the scratch pool holds is rejected.
      */
-    void execute_command(const std::string& input) {
-        auto tokens = split_command(input);
-        if (tokens.empty()) return;
-
-        auto cmd = tokens[0];
-        tokens.erase(tokens.begin());
-
-        auto it = commands.find(cmd);
-        if (it != commands.end()) {
+    void execute_command(std::string_view input) {
+        try {
+            MemoryArena::Scope command_scope(scratch);  // Frees the token vector on return
+            Args args(&scratch);
+            std::string_view name;
             try {
-                it->second.second(tokens);
-            } catch (const std::exception& e) {
-                logger.error("Command failed: " + std::string(e.what()));
+                name = split_command(input, args);
+            } catch (const std::bad_alloc&) {
+                LOG_ERROR(logger, "Command too long: out of scratch memory");
+                return;
             }
-        } else {
-            logger.warning("Unknown command: " + cmd);
+            if (name.empty()) return;
+
+            const Command* command = command_index().find(name);
+            if (!command) {
+                LOG_WARNING(logger, "Unknown command: {}", name);
+                return;
+            }
+            if (command->handler != &CLI::handle_submit) flush_submits();  // Keep the stream's order
+            (this->*command->handler)(args);
+        } catch (const std::exception& e) {
+            LOG_ERROR(logger, "Command failed: {}", e.what());
         }
     }
 
@@ -188,14 +342,14 @@ public:
      * Handles both interactive and test modes
      */
     void run() {
-        logger.info("Starting CLI interface");
+        LOG_INFO(logger, "Starting CLI interface");
         show_help();
 
         while (running) {
             if (!test_mode) {
                 std::cout << "> ";
                 std::string input;
-                std::getline(std::cin, input);
+                if (!std::getline(std::cin, input)) break;  // End of input
                 execute_command(input);
             } else {
                 break;  // Exit immediately in test mode
@@ -203,6 +357,64 @@ public:
         }
     }
 
+    /**
+     * Script Mode Operation
+     * --------------------
+     * Runs one command per line from a file or pipe until end of input or
+     * `exit`. Input is read SCRIPT_BLOCK bytes at a time and each line is
+     * executed in place; log output is buffered and flushed once per block
+     * rather than once per line. Blank lines and lines starting with '#'
+     * are skipped.
+     *
+     * @return: Number of commands executed
+     */
+    size_t run_script(std::istream& input) {
+        bool was_buffered = logger.buffered_output();
+        logger.set_buffered_output(true);
+
+        auto started = std::chrono::steady_clock::now();
+        std::vector<char> buffer(SCRIPT_BLOCK);
+        size_t pending = 0;  // Bytes of an unfinished line carried to the next block
+        size_t executed = 0;
+        bool at_end = false;
+
+        while (running && !at_end) {
+            if (pending == buffer.size()) buffer.resize(buffer.size() * 2);  // Line longer than a block
+            input.read(buffer.data() + pending, static_cast<std::streamsize>(buffer.size() - pending));
+            size_t filled = pending + static_cast<size_t>(input.gcount());
+            at_end = !input;
+
+            const char* cursor = buffer.data();
+            const char* end = buffer.data() + filled;
+            while (running) {
+                const char* newline = static_cast<const char*>(std::memchr(cursor, '\n', end - cursor));
+                if (!newline && !at_end) break;
+                const char* line_end = newline ? newline : end;
+                std::string_view line(cursor, static_cast<size_t>(line_end - cursor));
+                if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+                if (!line.empty() && line.front() != '#') {
+                    execute_command(line);
+                    ++executed;
+                }
+                if (!newline) {
+                    cursor = end;
+                    break;
+                }
+                cursor = newline + 1;
+            }
+
+            pending = static_cast<size_t>(end - cursor);
+            std::memmove(buffer.data(), cursor, pending);
+            logger.flush_output();
+        }
+
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+        LOG_INFO(logger, "Script executed {} commands in {} s", executed, seconds);
+        logger.set_buffered_output(was_buffered);
+        logger.flush_output();
+        return executed;
+    }
+
     /**
      * Test Mode Operation
      * ------------------
@@ -210,7 +422,7 @@ public:
      */
     void run_test_sequence(const std::vector<std::string>& commands) {
         for (const auto& cmd : commands) {
-            logger.info("Test executing: " + cmd);
+            LOG_INFO(logger, "Test executing: {}", cmd);
             execute_command(cmd);
         }
     }
@@ -222,48 +434,447 @@ private:
      * Individual command implementations
      */
     void show_help() {
+        logger.flush();  // Keep queued log lines ahead of direct output
         std::cout << "Available commands:\n";
-        for (const auto& cmd : commands) {
-            std::cout << "  " << cmd.first << " - " << cmd.second.first << "\n";
+        for (const auto& command : command_table()) {
+            std::cout << "  " << command.name << " - " << command.help << "\n";
         }
     }
 
-    void handle_allocate(const std::vector<std::string>& args) {
+    void handle_help(const Args&) { show_help(); }
+    void handle_stats(const Args&) { show_stats(); }
+    void handle_exit(const Args&) { running = false; }
+
+    void handle_allocate(const Args& args) {
         if (args.empty()) {
-            logger.error("Size argument required for allocate");
+            LOG_ERROR(logger, "Size argument required for allocate");
             return;
         }
 
+        uint64_t label = 0;
+        if (args.size() > 1 && !parse_label(args[1], label)) {
+            LOG_ERROR(logger, "Bad allocation label: {}", args[1]);
+            return;
+        }
+        if (args.size() > 2) {
+            if (args[2] != "movable") {
+                LOG_ERROR(logger, "Unknown allocation flag: {}", args[2]);
+                return;
+            }
+            allocate_movable(args[0], label);
+            return;
+        }
+
+        void* ptr = nullptr;
+        size_t size = 0;
+        if (!parse_number(args[0], size)) {
+            LOG_ERROR(logger, "Bad allocation size: {}", args[0]);
+            return;
+        }
         try {
-            size_t size = std::stoull(args[0]);
-            void* ptr = memory_pool.allocate(size);
-            logger.info("Allocated " + std::to_string(size) + " bytes at " + 
-                       std::to_string(reinterpret_cast<uintptr_t>(ptr)));
+            ptr = memory_pool.allocate(size);
+            LOG_INFO(logger, "Allocated {} bytes at {}", size, reinterpret_cast<uintptr_t>(ptr));
         } catch (const std::exception& e) {
-            logger.error("Allocation failed: " + std::string(e.what()));
+            LOG_ERROR(logger, "Allocation failed: {}", e.what());
+        }
+
+        // Failed attempts are recorded too: they load the allocator all the same
+        uint64_t trace_label = ptr && recorder.recording() ? next_trace_label++ : 0;
+        if (recorder.recording()) {
+            std::string event = "allocate " + std::string(args[0]);
+            if (trace_label) event += " @" + std::to_string(trace_label);
+            recorder.record(stream_id, event);
+        }
+        if (!ptr) return;
+        live_blocks[ptr] = trace_label;
+        if (label) labels[label] = ptr;  // Rebinding a label leaves the old block addressable
+    }
+
+    // Movable blocks have no stable address, so they are only known by label
+    void allocate_movable(std::string_view size_text, uint64_t label) {
+        if (movable.count(label)) {
+            LOG_ERROR(logger, "Label @{} already names a movable block", label);
+            return;
+        }
+
+        size_t size = 0;
+        if (!parse_number(size_text, size)) {
+            LOG_ERROR(logger, "Bad allocation size: {}", size_text);
+            return;
+        }
+        MemoryPool::Handle handle;
+        try {
+            handle = memory_pool.allocate_movable(size);
+            LOG_INFO(logger, "Allocated {} movable bytes as @{}", size, label);
+        } catch (const std::exception& e) {
+            LOG_ERROR(logger, "Allocation failed: {}", e.what());
+        }
+
+        uint64_t trace_label = handle && recorder.recording() ? next_trace_label++ : 0;
+        if (recorder.recording()) {
+            std::string event = "allocate " + std::string(size_text);
+            if (trace_label) event += " @" + std::to_string(trace_label) + " movable";
+            recorder.record(stream_id, event);
         }
+        if (handle) movable[label] = {handle, trace_label};
+    }
+
+    /**
+     * Replay Session
+     * -------------
+     * A session sharing the parent's subsystems and recorder, under its
+     * own stream id, so re-recording a replay keeps its streams apart
+     */
+    explicit CLI(CLI& parent)
+        : memory_pool(parent.memory_pool), device_driver(parent.device_driver),
+          logger(parent.logger), running(true), test_mode(true),
+          recorder(parent.recorder), stream_id(new_stream_id()), next_trace_label(1),
+          scratch_pool(SCRATCH_POOL), scratch(scratch_pool, SCRATCH_CHUNK), batch_submits(false) {
+    }
+
+    static uint32_t new_stream_id() {
+        static std::atomic<uint32_t> next_stream{0};
+        return next_stream.fetch_add(1, std::memory_order_relaxed);
     }
 
-    void handle_submit(const std::vector<std::string>& args) {
+    static bool parse_label(std::string_view text, uint64_t& label) {
+        if (text.size() < 2 || text[0] != '@') return false;
+        return parse_number(text.substr(1), label) && label != 0;
+    }
+
+    void handle_free(const Args& args) {
+        if (args.empty()) {
+            LOG_ERROR(logger, "Address or @label required for free");
+            return;
+        }
+
+        void* ptr = nullptr;
+        uint64_t label = 0;
+        if (parse_label(args[0], label)) {
+            auto handle = movable.find(label);
+            if (handle != movable.end()) {
+                if (handle->second.second && recorder.recording()) {
+                    recorder.record(stream_id, "free @" + std::to_string(handle->second.second));
+                }
+                memory_pool.deallocate(handle->second.first);
+                movable.erase(handle);
+                LOG_INFO(logger, "Freed movable block @{}", label);
+                return;
+            }
+            auto it = labels.find(label);
+            if (it == labels.end()) {
+                LOG_ERROR(logger, "Unknown allocation label: {}", args[0]);
+                return;
+            }
+            ptr = it->second;
+        } else {
+            uintptr_t address = 0;
+            if (!parse_number(args[0], address)) {
+                LOG_ERROR(logger, "Bad address: {}", args[0]);
+                return;
+            }
+            ptr = reinterpret_cast<void*>(address);
+        }
+
+        // Only blocks this CLI handed out: a stray address must not corrupt the pool
+        auto block = live_blocks.find(ptr);
+        if (block == live_blocks.end()) {
+            LOG_ERROR(logger, "Not an allocated block: {}", args[0]);
+            return;
+        }
+        if (block->second && recorder.recording()) recorder.record(stream_id, "free @" + std::to_string(block->second));
+        for (auto it = labels.begin(); it != labels.end();) {
+            it = it->second == ptr ? labels.erase(it) : std::next(it);
+        }
+        live_blocks.erase(block);
+        memory_pool.deallocate(ptr);
+        LOG_INFO(logger, "Freed block at {}", reinterpret_cast<uintptr_t>(ptr));
+    }
+
+    /**
+     * Compact Command
+     * --------------
+     * Without a budget, compacts to completion; with one, runs a single
+     * time-bounded step of the current pass
+     */
+    void handle_compact(const Args& args) {
+        MemoryPool::CompactionProgress progress;
+        if (args.empty()) {
+            progress = memory_pool.compact();
+        } else {
+            uint64_t budget_us = 0;
+            if (!parse_number(args[0], budget_us)) {
+                LOG_ERROR(logger, "Bad compaction budget: {}", args[0]);
+                return;
+            }
+            progress = memory_pool.compact_step(std::chrono::microseconds(budget_us));
+        }
+        if (recorder.recording()) recorder.record(stream_id, args.empty() ? "compact" : "compact " + std::string(args[0]));
+        LOG_INFO(logger, "Compaction moved {} blocks ({} bytes){}, fragmentation {}",
+                 progress.blocks_moved, progress.bytes_moved, progress.complete ? ", complete" : "",
+                 memory_pool.fragmentation_ratio());
+    }
+
+    /**
+     * Trim Command
+     * -----------
+     * Releases free blocks that stayed idle for `min_idle` earlier trims
+     * (default 1; 0 releases all free pages now)
+     */
+    void handle_trim(const Args& args) {
+        uint32_t min_idle = 1;
+        if (!args.empty() && !parse_number(args[0], min_idle)) {
+            LOG_ERROR(logger, "Bad idle epoch count: {}", args[0]);
+            return;
+        }
+        size_t released = memory_pool.trim(min_idle);
+        LOG_INFO(logger, "Released {} bytes of idle free memory to the OS", released);
+    }
+
+    void handle_submit(const Args& args) {
         if (args.size() < 2) {
-            logger.error("Operation and size arguments required for submit");
+            LOG_ERROR(logger, "Operation and size arguments required for submit");
+            return;
+        }
+
+        DeviceDriver::Opcode opcode;
+        if (!DeviceDriver::parse_opcode(args[0], opcode)) {
+            LOG_ERROR(logger, "Unknown operation: {} (expected read or write)", args[0]);
+            return;
+        }
+
+        DeviceDriver::Priority priority = DeviceDriver::Priority::BEST_EFFORT;
+        if (args.size() > 2) {
+            if (args[2] == "rt") priority = DeviceDriver::Priority::REALTIME;
+            else if (args[2] == "idle") priority = DeviceDriver::Priority::IDLE;
+            else if (args[2] != "be") {
+                LOG_ERROR(logger, "Unknown priority class: {}", args[2]);
+                return;
+            }
+        }
+
+        size_t size = 0;
+        uint64_t offset = 0;
+        if (!parse_number(args[1], size)) {
+            LOG_ERROR(logger, "Bad request size: {}", args[1]);
+            return;
+        }
+        if (args.size() > 3 && !parse_number(args[3], offset)) {
+            LOG_ERROR(logger, "Bad request offset: {}", args[3]);
             return;
         }
 
         try {
-            size_t size = std::stoull(args[1]);
-            if (device_driver.submit_request(args[0], size)) {
-                logger.info("Submitted device request: " + args[0] + 
-                          " with size " + std::to_string(size));
+            if (recorder.recording()) {
+                std::string event = "submit";
+                for (const auto& arg : args) event.append(" ").append(arg);
+                recorder.record(stream_id, event);
+            }
+            if (batch_submits) {
+                pending_submits.emplace_back(opcode, size, priority, offset);
+                if (pending_submits.size() >= SUBMIT_BATCH) flush_submits();
+                return;
+            }
+            if (device_driver.submit_request(opcode, size, priority, offset)) {
+                LOG_INFO(logger, "Submitted device request: {} with size {}", args[0], size);
             } else {
-                logger.warning("Device queue full");
+                LOG_WARNING(logger, "Device queue full");
+            }
+        } catch (const std::exception& e) {
+            LOG_ERROR(logger, "Submit failed: {}", e.what());
+        }
+    }
+
+    void flush_submits() {
+        if (pending_submits.empty()) return;
+        size_t accepted = device_driver.submit_batch(pending_submits);
+        if (accepted == pending_submits.size()) {
+            LOG_INFO(logger, "Submitted {} batched device requests", accepted);
+        } else {
+            LOG_WARNING(logger, "Device queue full: {} of {} batched requests rejected",
+                        pending_submits.size() - accepted, pending_submits.size());
+        }
+        pending_submits.clear();
+    }
+
+    void handle_scheduler(const Args& args) {
+        if (args.empty()) {
+            LOG_INFO(logger, "Current I/O scheduler: {}",
+                     DeviceDriver::scheduler_name(device_driver.get_scheduler()));
+            return;
+        }
+
+        for (auto policy : {DeviceDriver::Scheduler::FIFO, DeviceDriver::Scheduler::DEADLINE,
+                            DeviceDriver::Scheduler::SJF, DeviceDriver::Scheduler::PRIORITY}) {
+            if (args[0] == DeviceDriver::scheduler_name(policy)) {
+                device_driver.set_scheduler(policy);
+                LOG_INFO(logger, "I/O scheduler set to {}", args[0]);
+                return;
+            }
+        }
+        LOG_ERROR(logger, "Unknown scheduler: {}", args[0]);
+    }
+
+    void handle_backend(const Args& args) {
+        if (!args.empty() && args[0] == "simulated") {
+            device_driver.use_simulated_backend();
+            LOG_INFO(logger, "I/O backend set to simulated");
+        } else if (args.size() >= 2 && args[0] == "file") {
+            try {
+                device_driver.use_file_backend(std::string(args[1]));
+                LOG_INFO(logger, "I/O backend set to file {}", args[1]);
+            } catch (const std::exception& e) {
+                LOG_ERROR(logger, "Backend change failed: {}", e.what());
+            }
+        } else {
+            LOG_ERROR(logger, "Usage: backend <simulated|file <path>>");
+        }
+    }
+
+    void handle_merge(const Args& args) {
+        if (args.empty() || (args[0] != "on" && args[0] != "off")) {
+            LOG_ERROR(logger, "Usage: merge <on|off>");
+            return;
+        }
+        device_driver.set_merging(args[0] == "on");
+        LOG_INFO(logger, "Request merging {}", args[0] == "on" ? "enabled" : "disabled");
+    }
+
+    void handle_log(const Args& args) {
+        if (args.empty() || (args[0] != "sync" && args[0] != "async")) {
+            LOG_ERROR(logger, "Usage: log <sync|async [lossy|blocking]>");
+            return;
+        }
+        if (args[0] == "sync") {
+            logger.stop_async();
+            LOG_INFO(logger, "Logging synchronously");
+            return;
+        }
+
+        Logger::Overflow policy = Logger::Overflow::LOSSY;
+        if (args.size() > 1) {
+            if (args[1] == "blocking") policy = Logger::Overflow::BLOCKING;
+            else if (args[1] != "lossy") {
+                LOG_ERROR(logger, "Unknown overflow policy: {}", args[1]);
+                return;
+            }
+        }
+        logger.start_async(policy);
+        LOG_INFO(logger, "Logging asynchronously ({})",
+                 policy == Logger::Overflow::LOSSY ? "lossy" : "blocking");
+    }
+
+    void handle_binlog(const Args& args) {
+        if (args.empty()) {
+            LOG_ERROR(logger, "Usage: binlog <path|off>");
+            return;
+        }
+        BinaryLog& sink = BinaryLog::get_instance();
+        if (args[0] == "off") {
+            sink.close();
+            LOG_INFO(logger, "Binary log closed ({} records dropped)", sink.dropped());
+            return;
+        }
+        try {
+            sink.open(std::string(args[0]));
+            LOG_INFO(logger, "Binary log writing to {}", args[0]);
+        } catch (const std::exception& e) {
+            LOG_ERROR(logger, "Binary log open failed: {}", e.what());
+        }
+    }
+
+    /**
+     * Trace Command
+     * ------------
+     * record/stop capture this session's allocate, free, compact and submit events.
+     * replay runs a trace through fresh CLI sessions, one per recorded
+     * stream, so each stream's labels stay private to it; while recording,
+     * their events go to this trace under their own stream ids.
+     */
+    void handle_trace(const Args& args) {
+        if (!args.empty() && args[0] != "replay" && &recorder != &own_recorder) {
+            LOG_ERROR(logger, "Replay sessions record into their parent's trace");
+            return;
+        }
+        if (!args.empty() && args[0] == "stop") {
+            recorder.stop();
+            LOG_INFO(logger, "Trace recording stopped");
+            return;
+        }
+        if (args.size() < 2 || (args[0] != "record" && args[0] != "replay")) {
+            LOG_ERROR(logger, "Usage: trace <record <path>|stop|replay <path> [fast|timed] [threads]>");
+            return;
+        }
+
+        if (args[0] == "record") {
+            try {
+                recorder.start_recording(std::string(args[1]));
+            } catch (const std::exception& e) {
+                LOG_ERROR(logger, "Trace recording failed: {}", e.what());
+                return;
             }
+            for (auto& block : live_blocks) block.second = 0;  // Not in this trace
+            LOG_INFO(logger, "Recording trace to {}", args[1]);
+            return;
+        }
+
+        TraceReplayer::Mode mode = TraceReplayer::Mode::FAST;
+        if (args.size() > 2) {
+            if (args[2] == "timed") mode = TraceReplayer::Mode::TIMED;
+            else if (args[2] != "fast") {
+                LOG_ERROR(logger, "Unknown replay mode: {}", args[2]);
+                return;
+            }
+        }
+        size_t threads = 1;
+        if (args.size() > 3 && !parse_number(args[3], threads)) {
+            LOG_ERROR(logger, "Bad thread count: {}", args[3]);
+            return;
+        }
+        if (threads == 0) threads = 1;
+        if (threads > 1 && memory_pool.concurrency_mode() != MemoryPool::Concurrency::CONCURRENT) {
+            LOG_WARNING(logger, "Memory pool is single-threaded; replaying on one thread");
+            threads = 1;
+        }
+
+        try {
+            TraceReplayer replayer{std::string(args[1])};
+            std::vector<std::map<uint64_t, std::unique_ptr<CLI>>> sessions(threads);
+            auto stats = replayer.replay(
+                [&](size_t thread, uint64_t stream, const std::string& command) {
+                    auto& session = sessions[thread][stream];
+                    if (!session) {
+                        session.reset(new CLI(*this));
+                        session->set_batch_submits(mode == TraceReplayer::Mode::FAST);
+                    }
+                    session->execute_command(command);
+                },
+                mode, threads);
+            for (auto& thread_sessions : sessions) {
+                for (auto& session : thread_sessions) session.second->flush_submits();
+            }
+            LOG_INFO(logger, "Replayed {} events in {} s ({} malformed, max lag {} us)",
+                     stats.events, stats.seconds, stats.malformed, stats.max_lag_us);
         } catch (const std::exception& e) {
-            logger.error("Submit failed: " + std::string(e.what()));
+            LOG_ERROR(logger, "Trace replay failed: {}", e.what());
+        }
+    }
+
+    void handle_metrics(const Args& args) {
+        MetricsWriter::Format format = MetricsWriter::Format::JSON;
+        if (!args.empty() && !MetricsWriter::parse_format(args[0], format)) {
+            LOG_ERROR(logger, "Usage: metrics [json|prometheus]");
+            return;
         }
+        MetricsWriter writer(format);
+        memory_pool.export_metrics(writer);
+        device_driver.export_metrics(writer);
+        logger.flush();  // Keep queued log lines ahead of direct output
+        std::cout << writer.str();
     }
 
     void show_stats() {
+        logger.flush();  // Keep queued log lines ahead of direct output
         memory_pool.print_stats();
         device_driver.print_stats();
     }
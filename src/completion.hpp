@@ -0,0 +1,148 @@
+/*******************************************************************************
+ * Completion Table
+ * ---------------
+ * Fixed table of completion slots for asynchronous device requests, in the
+ * spirit of an NVMe command-id table or the kernel's blk-mq tag set:
+ *
+ * I. Concepts Demonstrated:
+ * 1. Tagged Requests
+ *    - A request carries only a small integer tag, not its completion state
+ *    - The tag indexes a preallocated slot holding the waiter
+ *
+ * 2. Completion Forms
+ *    - Callback invoked on the completing thread
+ *    - std::promise, surfaced to the submitter as a std::future
+ *
+ * 3. Lock-Free Tag Allocation
+ *    - Free tags live in an MpmcRingBuffer; acquire is a pop, release a push
+ *
+ * 4. Side-Table Request State
+ *    - Anything bulky or non-trivial about a request (waiter, payload
+ *      pointer) lives in its slot, so the queued record stays small and
+ *      trivially copyable
+ *
+ * Implementation Notes:
+ * - Tag 0 means "no completion requested"; slot i has tag i + 1
+ * - A slot is owned by exactly one request from acquire() until complete()
+ *   frees its tag, so slot contents need no further synchronization
+ * - Callbacks run on a worker thread and must not block for long
+ ******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <optional>
+#include <utility>
+#include "ring_buffer.hpp"
+
+template <typename Result>
+class CompletionTable {
+public:
+    using Callback = std::function<void(const Result&)>;
+    static constexpr uint32_t NO_TAG = 0;
+
+private:
+    struct Slot {
+        Callback callback;              // Set for callback completions
+        std::promise<Result> promise;   // Set for future completions
+        bool has_promise = false;
+        void* attachment = nullptr;     // Caller data carried with the request (e.g. payload)
+    };
+
+    std::unique_ptr<Slot[]> slots;
+    MpmcRingBuffer<uint32_t> free_tags;
+
+    Slot* claim() {
+        auto tag = free_tags.try_pop();
+        return tag ? &slots[*tag - 1] : nullptr;
+    }
+
+    uint32_t tag_of(const Slot* slot) const {
+        return static_cast<uint32_t>(slot - slots.get()) + 1;
+    }
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param capacity: Maximum number of completions pending at once
+     */
+    explicit CompletionTable(size_t capacity)
+        : slots(new Slot[capacity]), free_tags(capacity) {
+        for (size_t i = 0; i < capacity; ++i) free_tags.try_push(static_cast<uint32_t>(i + 1));
+    }
+
+    /**
+     * Tag Acquisition
+     * --------------
+     * @return: A tag bound to the waiter, or NO_TAG when the table is full
+     */
+    uint32_t acquire(Callback callback, void* attachment = nullptr) {
+        Slot* slot = claim();
+        if (!slot) return NO_TAG;
+        slot->callback = std::move(callback);
+        slot->attachment = attachment;
+        return tag_of(slot);
+    }
+
+    uint32_t acquire(std::future<Result>& future, void* attachment = nullptr) {
+        Slot* slot = claim();
+        if (!slot) return NO_TAG;
+        slot->attachment = attachment;
+        slot->promise = std::promise<Result>();
+        slot->has_promise = true;
+        future = slot->promise.get_future();
+        return tag_of(slot);
+    }
+
+    /**
+     * Attachment Lookup
+     * ----------------
+     * @return: The data bound at acquire(), or nullptr for NO_TAG
+     */
+    void* attachment(uint32_t tag) const {
+        return tag == NO_TAG ? nullptr : slots[tag - 1].attachment;
+    }
+
+    /**
+     * Tag Release Without Completion
+     * -----------------------------
+     * Returns a tag whose request was never queued; waiters are dropped
+     */
+    void cancel(uint32_t tag) {
+        if (tag == NO_TAG) return;
+        Slot& slot = slots[tag - 1];
+        slot.callback = nullptr;
+        slot.has_promise = false;
+        slot.attachment = nullptr;
+        slot.promise = std::promise<Result>();
+        free_tags.try_push(tag);
+    }
+
+    /**
+     * Completion Delivery
+     * ------------------
+     * Takes the waiter out of the slot and frees the tag before invoking
+     * the callback or fulfilling the promise, so a callback may submit
+     * follow-up work that reuses the tag. NO_TAG is ignored.
+     */
+    void complete(uint32_t tag, const Result& result) {
+        if (tag == NO_TAG) return;
+        Slot& slot = slots[tag - 1];
+        Callback callback = std::move(slot.callback);
+        slot.callback = nullptr;
+        slot.attachment = nullptr;
+        std::optional<std::promise<Result>> promise;
+        if (slot.has_promise) {
+            promise.emplace(std::move(slot.promise));
+            slot.has_promise = false;
+        }
+        free_tags.try_push(tag);
+
+        if (promise) promise->set_value(result);
+        if (callback) callback(result);
+    }
+};
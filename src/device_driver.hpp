@@ -15,9 +15,10 @@
  *    - Error recovery mechanisms
  * 
  * 3. I/O Scheduling
- *    - FIFO queue implementation
+ *    - Pluggable FIFO/deadline/SJF/priority policies (see io_scheduler.hpp)
  *    - Request batching optimization
  *    - Queue depth management
+ *    - Multiple workers with work-stealing (like blk-mq hardware queues)
  * 
  * II. Synchronization Patterns:
  * 1. Producer-Consumer Implementation
@@ -26,41 +27,64 @@
  *    - Buffer management
  * 
  * 2. Critical Section Protection
- *    - Mutex-based synchronization
- *    - Condition variable signaling
+ *    - Lock-free bounded MPMC request ring (see ring_buffer.hpp)
+ *    - Spin-then-park worker wakeup (see wait_strategy.hpp)
  *    - Deadlock prevention
  * 
  * III. Performance Considerations:
  * 1. Request Processing
  *    - Batch processing for efficiency
- *    - Simulated I/O latency
+ *    - Simulated I/O latency, or real file I/O via io_uring (see file_backend.hpp)
  *    - Queue size optimization
  * 
  * 2. Resource Management
  *    - Memory efficiency
- *    - Thread lifecycle
+ *    - Thread lifecycle: joinable workers, stop(DRAIN | CANCEL) with a
+ *      bounded drain phase, restartable after stop
  *    - Error handling overhead
  * 
  * Implementation Architecture:
- * [User Space]        [Kernel Space]        [Hardware]
- * Request --> Queue --> Driver Thread --> Simulated Device
- *   ^          |            |               |
- *   |          v            v               v
- * Response <- Status <-- Processing <-- I/O Complete
+ * [User Space]        [Kernel Space]              [Hardware]
+ * Request --> Ring --> Worker 0..N-1 (local queues) --> Simulated Device
+ *   ^          |            |    ^  steal  |               |
+ *   |          v            v    +---------+               v
+ * Response <- Status <-- Processing <------------------ I/O Complete
  * 
  * Error Handling:
  * - Queue full: Request rejection
+ * - Stopping: Submissions rejected; cancelled requests complete with failure
  * - Device error: State transition
  * - Thread failure: Graceful shutdown
  ******************************************************************************/
 
 #pragma once
 #include <string>
-#include <queue>
+#include <string_view>
 #include <chrono>
 #include <thread>
 #include <mutex>
 #include <condition_variable>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <optional>
+#include <array>
+#include <future>
+#include <stdexcept>
+#include <type_traits>
+#include <cstdint>
+#include <iostream>
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+#include <coroutine>
+#endif
+#include "ring_buffer.hpp"
+#include "completion.hpp"
+#include "memory_pool.hpp"
+#include "file_backend.hpp"
+#include "io_scheduler.hpp"
+#include "wait_strategy.hpp"
+#include "binary_log.hpp"
+#include "metrics.hpp"
 
 /**
  * DeviceDriver Class
@@ -76,18 +100,27 @@
  * 2. I/O Request Processing
  *    - Asynchronous operations
  *    - Request queueing
- *    - Completion handling
+ *    - Completion handling (future, callback or C++20 co_await)
  * 
  * 3. Resource Management
  *    - Queue depth control
+ *    - Zero-copy payloads owned by requests, returned to their MemoryPool
+ *    - 32-byte trivially copyable request records
  *    - Thread lifecycle
  *    - Error recovery
  * 
  * Implementation Details:
  * ----------------------
  * - Uses producer-consumer pattern
- * - Thread-safe operations
- * - FIFO scheduling
+ * - Lock-free submission: one CAS per request, no allocation in the queue
+ * - Producers only signal when a worker is parked
+ * - N workers pull batches from the shared ring into local queues;
+ *   idle workers steal half of a busy worker's backlog
+ * - Scheduling policy selectable at runtime; applied to each worker's
+ *   local queue, refilled up to SCHED_WINDOW requests deep
+ * - Always-on metrics: submits, rejections, queue depth at admission, and
+ *   per-request wait (submit to dispatch) and service (dispatch to
+ *   completion) times, exported by export_metrics() (see metrics.hpp)
  */
 class DeviceDriver {
 public:
@@ -108,140 +141,1017 @@ public:
         ERROR   // Error condition detected
     };
 
+    using Scheduler = SchedulerPolicy;
+    using Priority = IoPriority;
+
+    /**
+     * I/O Backend Selection
+     * --------------------
+     * - SIMULATED: Sleep for a size-proportional time (deterministic)
+     * - FILE_IO:   Real reads/writes on a file or block device (see file_backend.hpp)
+     */
+    enum class Backend {
+        SIMULATED,
+        FILE_IO
+    };
+
+    /**
+     * Operation Codes
+     * --------------
+     * Parsed from text only at the CLI boundary
+     */
+    enum class Opcode : uint8_t {
+        READ,
+        WRITE
+    };
+
     /**
      * Device Request Structure
      * -----------------------
-     * Represents an I/O request with:
-     * - Operation type (read/write)
+     * A fixed-size, trivially copyable record (like an NVMe submission
+     * entry) so the ring holds requests densely and moves them by memcpy:
+     * - Operation code (read/write)
      * - Data size
-     * - Timestamp for request tracking
+     * - Timestamp for request tracking and deadlines
+     * - Priority class
+     * - Completion tag linking it to a waiting future, callback or payload
+     * - Device offset
+     *
+     * Anything bulky (waiter, payload pointer) lives in the completion
+     * table slot named by the tag.
      */
     struct DeviceRequest {
-        std::string operation;  // Type of I/O operation (e.g., "read", "write")
-        size_t data_size;       // Amount of data to be read or written
         std::chrono::steady_clock::time_point timestamp; // Timestamp of request submission
+        uint64_t offset;        // Byte offset on the device (file backend)
+        uint32_t data_size;     // Amount of data to be read or written
+        uint32_t completion_tag;  // Completion slot, set by the driver (0 = none)
+        Opcode opcode;          // Type of I/O operation
+        Priority priority;      // Scheduling class under Scheduler::PRIORITY
+
+        static constexpr size_t MAX_DATA_SIZE = UINT32_MAX;
 
         /**
          * Constructor for DeviceRequest
          * @param op The type of operation
-         * @param size The size of the data
+         * @param size The size of the data (at most MAX_DATA_SIZE)
+         * @param prio The request's priority class
+         * @param off The device byte offset
+         * @throws std::invalid_argument if size exceeds MAX_DATA_SIZE
          */
-        DeviceRequest(const std::string& op, size_t size)
-            : operation(op), data_size(size),
-              timestamp(std::chrono::steady_clock::now()) {}
+        DeviceRequest(Opcode op, size_t size, Priority prio = Priority::BEST_EFFORT, uint64_t off = 0)
+            : timestamp(std::chrono::steady_clock::now()), offset(off),
+              data_size(static_cast<uint32_t>(size)), completion_tag(0), opcode(op), priority(prio) {
+            if (size > MAX_DATA_SIZE) throw std::invalid_argument("Device request too large");
+        }
+
+        bool is_read() const { return opcode == Opcode::READ; }
+    };
+
+    /**
+     * Completion Result
+     * ----------------
+     * Delivered to the submitter's future, callback or coroutine once the
+     * request (or the merged command containing it) finishes.
+     */
+    struct Completion {
+        bool success;                       // I/O finished without error
+        size_t bytes;                       // Bytes transferred for this request
+        std::chrono::nanoseconds latency;   // Submission to completion
+        void* payload;                      // Request payload; valid only until the callback returns
+    };
+
+    using Callback = CompletionTable<Completion>::Callback;
+
+    static constexpr size_t MAX_WORKERS = 64;
+    static constexpr std::chrono::milliseconds DEFAULT_STOP_TIMEOUT{5000};
+
+    /**
+     * Shutdown Modes
+     * -------------
+     * DRAIN:  Finish every admitted request, then stop
+     * CANCEL: Finish only in-flight commands; fail the rest
+     */
+    enum class StopMode {
+        DRAIN,
+        CANCEL
     };
 
+    static_assert(std::is_trivially_copyable<DeviceRequest>::value,
+                  "DeviceRequest must stay trivially copyable");
+    static_assert(sizeof(DeviceRequest) <= 32, "DeviceRequest must fit in 32 bytes");
+
+    /**
+     * Opcode Names
+     * -----------
+     */
+    static const char* opcode_name(Opcode op) {
+        return op == Opcode::READ ? "read" : "write";
+    }
+
+    static bool parse_opcode(std::string_view text, Opcode& op) {
+        if (text == "read") op = Opcode::READ;
+        else if (text == "write") op = Opcode::WRITE;
+        else return false;
+        return true;
+    }
+
 private:
-    Status status;                    // Current device status
-    std::queue<DeviceRequest> request_queue;  // Queue of pending I/O requests
-    mutable std::mutex mutex;         // Mutex for thread synchronization
-    std::condition_variable cv;       // Condition variable for thread signaling
-    bool processing;                  // Flag indicating whether the processing thread is active
     static constexpr size_t MAX_QUEUE_SIZE = 100;  // Maximum number of requests allowed in the queue
+    static constexpr size_t PULL_BATCH = 8;        // Requests moved from the ring per refill
+    static constexpr size_t SCHED_WINDOW = 32;     // Local backlog at which refills stop
+    static constexpr size_t MAX_MERGE_SIZE = 128 * 1024;  // Largest merged command (max_sectors_kb)
+    static constexpr size_t MAX_MERGE_REQUESTS = 32;      // Largest merged command, in requests
+    static_assert(MAX_MERGE_REQUESTS <= FileBackend::MAX_SEGMENTS, "Merged command must fit one vectored op");
+    static constexpr std::chrono::microseconds COMMAND_OVERHEAD{100};  // Per-command device setup cost
+
+    /**
+     * Dispatch Unit
+     * ------------
+     * One device command: a request plus any compatible requests merged
+     * behind it. All constituents complete when the command does.
+     */
+    struct Constituent {
+        uint32_t completion_tag;
+        size_t data_size;
+        uint64_t offset;
+        void* payload;
+        std::chrono::steady_clock::time_point timestamp;
+    };
+
+    struct Dispatch {
+        DeviceRequest head;     // First request; carries opcode and priority
+        size_t constituents;    // Requests folded into this command
+        size_t total_size;      // Combined data size
+        std::array<Constituent, MAX_MERGE_REQUESTS> members;  // Per-request completion data
+
+        Dispatch(const DeviceRequest& first, void* payload)
+            : head(first), constituents(0), total_size(0) {
+            add(head, payload);
+        }
+
+        void add(const DeviceRequest& request, void* payload) {
+            members[constituents++] = {request.completion_tag, request.data_size, request.offset,
+                                       payload, request.timestamp};
+            total_size += request.data_size;
+        }
+    };
+
+    /**
+     * Worker State
+     * -----------
+     * One per processing thread, on its own cache line. The local scheduler
+     * queue is guarded by a per-worker mutex that is only contended by thieves.
+     */
+    struct alignas(64) Worker {
+        std::mutex mutex;                   // Guards queue
+        IoScheduler<DeviceRequest> queue;   // Requests claimed by this worker, in dispatch order
+        std::atomic<Status> status{Status::READY};  // Per-worker device status
+        std::atomic<size_t> completed{0};   // Requests finished by this worker
+        std::atomic<size_t> dispatched{0};  // Device commands issued (after merging)
+        std::atomic<size_t> stolen{0};      // Requests taken from other workers
+        std::atomic<size_t> failed{0};      // Requests completed with an I/O error
+        std::shared_ptr<FileBackend> io_backend;          // Backend io_context belongs to (worker-only)
+        MemoryPool* io_region = nullptr;                  // Payload pool io_context registered (worker-only)
+        bool io_pinned = false;                           // io_region pinned: its registration succeeded (worker-only)
+        std::unique_ptr<FileBackend::Context> io_context; // This worker's ring and buffers (worker-only)
+    };
+
+    size_t worker_count;              // Number of processing threads
+    std::unique_ptr<Worker[]> workers;  // Per-worker queues and status
+    MpmcRingBuffer<DeviceRequest> request_queue;  // Lock-free ring of pending I/O requests
+    std::atomic<size_t> outstanding;  // Requests queued in the ring, a local queue or in flight
+    std::atomic<size_t> local_pending;  // Requests sitting in local queues (stealable)
+    std::atomic<Scheduler> scheduler; // Policy applied to every local queue
+    std::atomic<bool> merging;        // Merge compatible neighbours before dispatch
+    CompletionTable<Completion> completions;  // Futures/callbacks by completion tag
+    std::shared_ptr<FileBackend> file_backend;  // Real-file backend, or null for simulated (atomic access)
+    std::atomic<MemoryPool*> payload_pool;  // Pool that payload blocks come from and return to
+    AdaptiveWaiter waiter;            // Spin-then-park worker wakeup
+
+    StripedCounter submitted;         // Requests admitted
+    StripedCounter rejected;          // Submits refused: queue full or stopping
+    Histogram queue_depth;            // Outstanding requests, sampled at each admission
+    Histogram wait_time;              // Submission to dispatch, ns
+    Histogram service_time;           // Dispatch to completion, ns
+
+    /**
+     * Lifecycle State
+     * --------------
+     * STOPPED -> RUNNING on start; RUNNING -> DRAINING or CANCELLING on
+     * stop, then back to STOPPED once every thread has been joined
+     */
+    enum class RunState : uint8_t {
+        STOPPED,
+        RUNNING,
+        DRAINING,
+        CANCELLING
+    };
+
+    std::atomic<RunState> run_state;  // Shared run flag read by every worker
+    std::mutex lifecycle;             // Serializes start/stop
+    std::vector<std::thread> worker_threads;  // Joinable processing threads
+    std::mutex exit_mutex;            // Guards live_workers for exit_cv
+    std::condition_variable exit_cv;  // Signalled as each worker exits
+    size_t live_workers;              // Processing threads not yet exited
+
+    /**
+     * Merge Compatibility
+     * ------------------
+     * Same operation and priority class, starting where the command ends
+     * (a back merge, so the command stays one contiguous range), and the
+     * merged command stays within MAX_MERGE_SIZE bytes and
+     * MAX_MERGE_REQUESTS requests
+     */
+    static bool can_merge(const Dispatch& dispatch, const DeviceRequest& next) {
+        return dispatch.constituents < MAX_MERGE_REQUESTS &&
+               next.opcode == dispatch.head.opcode &&
+               next.priority == dispatch.head.priority &&
+               next.offset == dispatch.head.offset + dispatch.total_size &&
+               dispatch.total_size + next.data_size <= MAX_MERGE_SIZE;
+    }
+
+    /**
+     * Local Work Acquisition
+     * ---------------------
+     * Tops the local queue up from the shared ring (one CAS per batch) so
+     * the scheduler has a window to reorder, then dispatches the request
+     * the policy ranks first, merged with any compatible requests that the
+     * policy ranks immediately after it.
+     */
+    std::optional<Dispatch> take_local(Worker& self) {
+        std::optional<Dispatch> dispatch;
+        bool surplus = false;
+        {
+            std::lock_guard<std::mutex> lock(self.mutex);
+            size_t pulled = 0;
+            if (self.queue.size() < SCHED_WINDOW) {
+                pulled = request_queue.try_pop_bulk(self.queue.inserter(), PULL_BATCH);
+            }
+            local_pending.fetch_add(pulled, std::memory_order_relaxed);
+            surplus = pulled > 1;
+
+            auto request = self.queue.pop();
+            if (request) {
+                dispatch.emplace(*request, completions.attachment(request->completion_tag));
+                if (merging.load(std::memory_order_relaxed)) {
+                    for (const DeviceRequest* next = self.queue.top();
+                         next && can_merge(*dispatch, *next); next = self.queue.top()) {
+                        dispatch->add(*next, completions.attachment(next->completion_tag));
+                        self.queue.pop();
+                    }
+                }
+
+                // Counted under the lock so a thief can never drive it below zero
+                local_pending.fetch_sub(dispatch->constituents, std::memory_order_relaxed);
+            }
+        }
+        if (surplus) waiter.notify_one();  // Let an idle worker steal the surplus
+        return dispatch;
+    }
+
+    /**
+     * Submission Helpers
+     * -----------------
+     * Admission: at most MAX_QUEUE_SIZE requests pending across the ring,
+     * worker queues and in-flight commands, so neither the ring nor the
+     * completion table can be full once a request is admitted.
+     */
+    bool admit() {
+        if (stopping()) {  // Queue is being shut down
+            rejected.add(0);
+            return false;
+        }
+        size_t depth = outstanding.fetch_add(1, std::memory_order_relaxed);
+        if (depth >= MAX_QUEUE_SIZE) {
+            outstanding.fetch_sub(1, std::memory_order_relaxed);
+            rejected.add(0);
+            return false;
+        }
+        submitted.add(0);
+        queue_depth.record(depth + 1);
+        return true;
+    }
+
+    bool stopping() const {
+        RunState state = run_state.load(std::memory_order_acquire);
+        return state == RunState::DRAINING || state == RunState::CANCELLING;
+    }
+
+    void publish(DeviceRequest&& request) {
+        BLOG(Logger::Level::DEBUG, "DeviceDriver submit {} {} bytes at {} tag {}",
+             opcode_name(request.opcode), request.data_size, request.offset, request.completion_tag);
+        request_queue.try_push(std::move(request));
+
+        // Wake a processing thread only if one has parked
+        waiter.notify_one();
+    }
+
+    /**
+     * Work Stealing
+     * ------------
+     * Moves the less urgent half of another worker's queue into our own.
+     * @return True if anything was stolen
+     */
+    bool steal(size_t self_index) {
+        Worker& self = workers[self_index];
+        for (size_t offset = 1; offset < worker_count; ++offset) {
+            Worker& victim = workers[(self_index + offset) % worker_count];
+            std::scoped_lock lock(victim.mutex, self.mutex);
+            size_t moved = victim.queue.steal_half(self.queue);
+            if (moved == 0) continue;
+            self.stolen.fetch_add(moved, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+
+    /**
+     * Real I/O Execution
+     * -----------------
+     * Issues the command on this worker's own ring, created on first use
+     * of each backend. A merged command is one vectored op over its whole
+     * range (one SQE), and each constituent is credited with the bytes
+     * transferred within its slice of that range.
+     */
+    void execute_on_file(Worker& self, const std::shared_ptr<FileBackend>& backend,
+                         const Dispatch& dispatch, FileBackend::Result* results) {
+        MemoryPool* pool = payload_pool.load(std::memory_order_acquire);
+        if (self.io_backend != backend || self.io_region != pool) {
+            release_io_context(self);
+            if (pool) {
+                // Pinned before registration: a trim() racing make_context()
+                // could otherwise drop pages the ring has just pinned
+                pool->pin_region();
+                try {
+                    self.io_context = backend->make_context(pool->region(), pool->capacity());
+                } catch (...) {
+                    pool->unpin_region();
+                    throw;
+                }
+                self.io_pinned = self.io_context->region_registered();
+                if (!self.io_pinned) pool->unpin_region();  // Plain READ/WRITE; nothing held
+            } else {
+                self.io_context = backend->make_context();
+            }
+            self.io_backend = backend;
+            self.io_region = pool;
+        }
+
+        bool write = !dispatch.head.is_read();
+        const Constituent& head = dispatch.members[0];
+        if (dispatch.constituents == 1) {
+            FileBackend::Op op{write, head.offset, head.data_size, static_cast<char*>(head.payload)};
+            backend->execute(*self.io_context, &op, 1, results);
+        } else {
+            std::array<FileBackend::Segment, MAX_MERGE_REQUESTS> segments;
+            for (size_t i = 0; i < dispatch.constituents; ++i) {
+                const Constituent& member = dispatch.members[i];
+                segments[i] = FileBackend::Segment{static_cast<char*>(member.payload), member.data_size};
+            }
+            FileBackend::Op op{write, head.offset, dispatch.total_size, nullptr,
+                               segments.data(), dispatch.constituents};
+            FileBackend::Result merged;
+            backend->execute(*self.io_context, &op, 1, &merged);
+
+            size_t remaining = merged.bytes;  // Short transfers end partway through the range
+            for (size_t i = 0; i < dispatch.constituents; ++i) {
+                size_t bytes = remaining < dispatch.members[i].data_size ? remaining : dispatch.members[i].data_size;
+                results[i] = FileBackend::Result{merged.success, bytes};
+                remaining -= bytes;
+            }
+        }
+
+        // A ring closed after an io_uring_enter failure no longer holds the region
+        if (self.io_pinned && !self.io_context->region_registered()) {
+            self.io_region->unpin_region();
+            self.io_pinned = false;
+        }
+    }
+
+    /**
+     * I/O Context Release
+     * ------------------
+     * Closes the worker's ring, unregistering its buffers, then lets the
+     * payload pool trim again.
+     */
+    void release_io_context(Worker& self) {
+        self.io_context.reset();
+        self.io_backend.reset();
+        if (self.io_pinned) self.io_region->unpin_region();
+        self.io_region = nullptr;
+        self.io_pinned = false;
+    }
+
+    /**
+     * Worker Main Loop
+     * ---------------
+     * Runs on each processing thread until stop(). Under DRAIN a worker
+     * exits once there is nothing left to take or steal; under CANCEL it
+     * exits after its current command.
+     */
+    void worker_loop(size_t index) {
+        Worker& self = workers[index];
+        for (;;) {
+            RunState state = run_state.load(std::memory_order_acquire);
+            if (state == RunState::CANCELLING) break;
+
+            auto dispatch = take_local(self);
+            if (!dispatch && steal(index)) continue;
+
+            if (!dispatch) {
+                if (state == RunState::DRAINING && request_queue.empty()) break;
+
+                // Spin, then park, while there is nothing to run or steal
+                self.status.store(Status::READY, std::memory_order_relaxed);
+                waiter.wait([this] {
+                    return !request_queue.empty() ||
+                           local_pending.load(std::memory_order_relaxed) > 0 ||
+                           run_state.load(std::memory_order_acquire) != RunState::RUNNING;
+                });
+                continue;
+            }
+
+            // Process the (possibly merged) command
+            self.status.store(Status::BUSY, std::memory_order_relaxed);
+            auto started = std::chrono::steady_clock::now();
+
+            std::array<FileBackend::Result, MAX_MERGE_REQUESTS> results;
+            auto backend = std::atomic_load(&file_backend);
+            if (backend) {
+                execute_on_file(self, backend, *dispatch, results.data());
+            } else {
+                // Simulate I/O time: fixed command setup plus time based on data size
+                if (self.io_backend) release_io_context(self);
+                std::this_thread::sleep_for(
+                    COMMAND_OVERHEAD + std::chrono::milliseconds(dispatch->total_size / 1024)
+                );
+                for (size_t i = 0; i < dispatch->constituents; ++i) {
+                    results[i] = FileBackend::Result{true, dispatch->members[i].data_size};
+                }
+            }
+
+            // Complete every constituent; tags are freed before the queue
+            // slot so an admitted submitter always finds a free tag
+            auto now = std::chrono::steady_clock::now();
+            for (size_t i = 0; i < dispatch->constituents; ++i) {
+                const Constituent& member = dispatch->members[i];
+                if (!results[i].success) self.failed.fetch_add(1, std::memory_order_relaxed);
+                wait_time.record(nanoseconds_between(member.timestamp, started));
+                service_time.record(nanoseconds_between(started, now));
+                BLOG(Logger::Level::DEBUG, "DeviceDriver worker {} {} {} bytes at {} in {} ns ok {}",
+                     index, opcode_name(dispatch->head.opcode), member.data_size, member.offset,
+                     std::chrono::duration_cast<std::chrono::nanoseconds>(now - member.timestamp).count(),
+                     results[i].success);
+                completions.complete(member.completion_tag,
+                                     Completion{results[i].success, results[i].bytes,
+                                                now - member.timestamp, member.payload});
+
+                // The payload's journey ends here: back to the pool it came from
+                if (member.payload) payload_pool.load(std::memory_order_acquire)->deallocate(member.payload);
+            }
+            self.dispatched.fetch_add(1, std::memory_order_relaxed);
+            self.completed.fetch_add(dispatch->constituents, std::memory_order_relaxed);
+            outstanding.fetch_sub(dispatch->constituents, std::memory_order_relaxed);
+        }
+
+        release_io_context(self);  // Unpins the payload pool once workers stop
+        self.status.store(Status::READY, std::memory_order_relaxed);
+        std::lock_guard<std::mutex> lock(exit_mutex);
+        --live_workers;
+        exit_cv.notify_all();
+    }
+
+    static uint64_t nanoseconds_between(std::chrono::steady_clock::time_point from,
+                                        std::chrono::steady_clock::time_point to) {
+        return to > from ? static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(to - from).count()) : 0;
+    }
+
+    /**
+     * Queued Request Cancellation
+     * --------------------------
+     * Fails a request that never reached the device: its waiter sees
+     * success == false and its payload goes back to the pool.
+     */
+    void cancel_request(const DeviceRequest& request) {
+        void* payload = completions.attachment(request.completion_tag);
+        completions.complete(request.completion_tag,
+                             Completion{false, 0, std::chrono::steady_clock::now() - request.timestamp,
+                                        payload});
+        if (payload) payload_pool.load(std::memory_order_acquire)->deallocate(payload);
+        outstanding.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Residual Sweep
+     * -------------
+     * Only called with every worker joined, so the ring and local queues
+     * have no other consumers.
+     * @return Number of requests cancelled
+     */
+    size_t cancel_queued() {
+        size_t cancelled = 0;
+        while (auto request = request_queue.try_pop()) {
+            cancel_request(*request);
+            ++cancelled;
+        }
+        for (size_t i = 0; i < worker_count; ++i) {
+            std::lock_guard<std::mutex> lock(workers[i].mutex);
+            while (auto request = workers[i].queue.pop()) {
+                local_pending.fetch_sub(1, std::memory_order_relaxed);
+                cancel_request(*request);
+                ++cancelled;
+            }
+        }
+        return cancelled;
+    }
 
 public:
     /**
      * Constructor: Initializes the device driver in the READY state.
+     * @param threads Number of processing threads (1..MAX_WORKERS)
+     * @param policy Initial I/O scheduling policy
+     */
+    explicit DeviceDriver(size_t threads = 1, Scheduler policy = Scheduler::FIFO)
+        : worker_count(threads < 1 ? 1 : (threads > MAX_WORKERS ? MAX_WORKERS : threads)),
+          workers(new Worker[worker_count]), request_queue(MAX_QUEUE_SIZE),
+          outstanding(0), local_pending(0), scheduler(policy), merging(false),
+          completions(MAX_QUEUE_SIZE), payload_pool(nullptr),
+          run_state(RunState::STOPPED), live_workers(0) {
+        for (size_t i = 0; i < worker_count; ++i) workers[i].queue.set_policy(policy);
+    }
+
+    /**
+     * Destructor: Cancels queued work and joins every processing thread,
+     * so no worker outlives the driver.
      */
-    DeviceDriver() : status(Status::READY), processing(false) {}
+    ~DeviceDriver() {
+        stop(StopMode::CANCEL);
+    }
+
+    DeviceDriver(const DeviceDriver&) = delete;
+    DeviceDriver& operator=(const DeviceDriver&) = delete;
 
     /**
      * Request Submission
      * -----------------
      * Submits a new I/O request to the device driver.
-     * @param operation The type of operation ("read" or "write")
+     * @param operation The type of operation
      * @param data_size The size of the data in bytes
+     * @param priority The request's class under Scheduler::PRIORITY
+     * @param offset Device byte offset (used by the file backend)
+     * @return True if the request was successfully submitted, false if the queue is full.
+     * @throws std::invalid_argument if data_size exceeds DeviceRequest::MAX_DATA_SIZE
+     */
+    bool submit_request(Opcode operation, size_t data_size,
+                        Priority priority = Priority::BEST_EFFORT, uint64_t offset = 0) {
+        if (!admit()) return false;  // Queue is full, request rejected
+        publish(DeviceRequest(operation, data_size, priority, offset));
+        return true;
+    }
+
+    /**
+     * Request Submission With Callback
+     * -------------------------------
+     * As submit_request(), and invokes on_complete on a worker thread when
+     * the request finishes. The callback is not invoked if the request is
+     * rejected.
      * @return True if the request was successfully submitted, false if the queue is full.
      */
-    bool submit_request(const std::string& operation, size_t data_size) {
-        std::lock_guard<std::mutex> lock(mutex);  // Acquire lock for thread safety
+    bool submit_request(Opcode operation, size_t data_size, Callback on_complete,
+                        Priority priority = Priority::BEST_EFFORT, uint64_t offset = 0) {
+        if (!admit()) return false;  // Queue is full, request rejected
+        DeviceRequest request(operation, data_size, priority, offset);
+        request.completion_tag = completions.acquire(std::move(on_complete));
+        publish(std::move(request));
+        return true;
+    }
 
-        // Check if the request queue is full
-        if (request_queue.size() >= MAX_QUEUE_SIZE) {
-            return false;  // Queue is full, request rejected
+    /**
+     * Asynchronous Submission
+     * ----------------------
+     * @return A future that becomes ready when the request finishes. If the
+     *         queue is full, the future holds a std::runtime_error instead.
+     */
+    std::future<Completion> submit_async(Opcode operation, size_t data_size,
+                                         Priority priority = Priority::BEST_EFFORT,
+                                         uint64_t offset = 0) {
+        std::future<Completion> future;
+        if (!admit()) {
+            std::promise<Completion> rejected;
+            rejected.set_exception(std::make_exception_ptr(std::runtime_error("Device queue full")));
+            return rejected.get_future();
         }
+        DeviceRequest request(operation, data_size, priority, offset);
+        request.completion_tag = completions.acquire(future);
+        publish(std::move(request));
+        return future;
+    }
 
-        // Add the request to the queue
-        request_queue.emplace(operation, data_size);
-        // Signal the processing thread that a new request has arrived
-        cv.notify_one();
+    /**
+     * Zero-Copy Payload Submission
+     * ---------------------------
+     * Submits a request whose data lives in a block allocated from the
+     * payload pool. On success the request owns the block: the device
+     * reads or writes it in place, on_complete (if any) sees it through
+     * Completion::payload, and it is then returned to the pool. On
+     * rejection ownership stays with the caller.
+     * @param operation The type of operation
+     * @param payload Block from the payload pool
+     * @param size Bytes of the block to transfer
+     * @return True if the request was successfully submitted, false if the queue is full.
+     * @throws std::logic_error if no payload pool has been set
+     * @throws std::invalid_argument if payload is not a block of the payload
+     *         pool or size exceeds it (the device would overrun the block)
+     */
+    bool submit_payload(Opcode operation, void* payload, size_t size,
+                        Callback on_complete = nullptr,
+                        Priority priority = Priority::BEST_EFFORT, uint64_t offset = 0) {
+        MemoryPool* pool = payload_pool.load(std::memory_order_relaxed);
+        if (!pool) {
+            throw std::logic_error("No payload pool set for zero-copy submission");
+        }
+        size_t usable = pool->usable_size(payload);
+        if (usable == 0) {
+            throw std::invalid_argument("Payload is not a block of the payload pool");
+        }
+        if (size > usable) {
+            throw std::invalid_argument("Payload size " + std::to_string(size) +
+                                        " exceeds its " + std::to_string(usable) + "-byte block");
+        }
+        DeviceRequest request(operation, size, priority, offset);
+        if (!admit()) return false;  // Queue is full, request rejected
+        request.completion_tag = completions.acquire(std::move(on_complete), payload);
+        publish(std::move(request));
         return true;
     }
 
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L
+    /**
+     * Coroutine Awaitable
+     * ------------------
+     * co_await driver.submit_awaitable(Opcode::READ, 4096) suspends until the
+     * request completes and yields its Completion. The coroutine resumes on
+     * the worker thread that completed the request. A rejected request
+     * resumes immediately with success == false and bytes == 0.
+     */
+    class RequestAwaitable {
+        DeviceDriver& driver;
+        Opcode operation;
+        size_t data_size;
+        Priority priority;
+        Completion result;
+
+    public:
+        RequestAwaitable(DeviceDriver& dd, Opcode op, size_t size, Priority prio)
+            : driver(dd), operation(op), data_size(size), priority(prio),
+              result{false, 0, std::chrono::nanoseconds(0), nullptr} {}
+
+        bool await_ready() const noexcept { return false; }
+
+        bool await_suspend(std::coroutine_handle<> handle) {
+            return driver.submit_request(operation, data_size,
+                [this, handle](const Completion& completion) {
+                    result = completion;
+                    handle.resume();
+                }, priority);
+        }
+
+        Completion await_resume() const noexcept { return result; }
+    };
+
+    RequestAwaitable submit_awaitable(Opcode operation, size_t data_size,
+                                      Priority priority = Priority::BEST_EFFORT) {
+        return RequestAwaitable(*this, operation, data_size, priority);
+    }
+#endif
+
+    /**
+     * Batch Submission
+     * ---------------
+     * Admits as many of the requests as fit under the queue limit with one
+     * counter update, publishes them with bulk ring pushes and issues a
+     * single wakeup. Requests past the limit are rejected, in order.
+     * Accepted requests are stamped with the submission time here, so
+     * wait-time metrics do not depend on when the caller built them.
+     * Batched requests have no waiter: completion_tag must be 0.
+     * Submit/reject counters, the queue depth histogram and the submit
+     * trace see each request exactly as if it had been submitted alone.
+     * @param requests Array of requests to submit
+     * @param count Number of requests in the array
+     * @return The number of requests accepted (a prefix of the array).
+     * @throws std::invalid_argument if a request carries a completion tag
+     */
+    size_t submit_batch(DeviceRequest* requests, size_t count) {
+        for (size_t i = 0; i < count; ++i) {
+            if (requests[i].completion_tag != 0) {
+                throw std::invalid_argument("Batched device requests cannot carry a completion tag");
+            }
+        }
+        if (count == 0) return 0;
+        if (stopping()) {  // Queue is being shut down
+            rejected.add(0, count);
+            return 0;
+        }
+        size_t current = outstanding.load(std::memory_order_relaxed);
+        size_t accepted;
+        do {
+            if (current >= MAX_QUEUE_SIZE) {  // Queue is full, batch rejected
+                rejected.add(0, count);
+                return 0;
+            }
+            accepted = count < MAX_QUEUE_SIZE - current ? count : MAX_QUEUE_SIZE - current;
+        } while (!outstanding.compare_exchange_weak(current, current + accepted,
+                                                    std::memory_order_relaxed));
+        submitted.add(0, accepted);
+        if (accepted < count) rejected.add(0, count - accepted);
+
+        auto now = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < accepted; ++i) {
+            DeviceRequest& request = requests[i];
+            request.timestamp = now;
+            queue_depth.record(current + i + 1);
+            BLOG(Logger::Level::DEBUG, "DeviceDriver submit {} {} bytes at {} tag {}",
+                 opcode_name(request.opcode), request.data_size, request.offset, request.completion_tag);
+        }
+
+        // Admission guarantees ring space; retries only race other producers
+        size_t pushed = 0;
+        while (pushed < accepted) {
+            pushed += request_queue.try_push_bulk(requests + pushed, accepted - pushed);
+        }
+
+        waiter.notify_one();
+        return accepted;
+    }
+
+    size_t submit_batch(std::vector<DeviceRequest>& requests) {
+        return submit_batch(requests.data(), requests.size());
+    }
+
     /**
      * Start Request Processing
      * -----------------------
-     * Starts a background thread to process I/O requests asynchronously.
-     * Simulates device I/O operations with simulated latency.
+     * Starts the background worker threads that process I/O requests
+     * asynchronously. Simulates device I/O operations with simulated latency.
+     * Requests submitted while stopped stay queued until the next start.
+     * No-op if already running.
      */
     void start_processing() {
-        processing = true;
-        std::thread([this]() {
-            while (processing) {
-                std::unique_lock<std::mutex> lock(mutex);
-
-                // Wait for requests if the queue is empty
-                if (request_queue.empty()) {
-                    status = Status::READY;
-                    cv.wait(lock); // Wait for a request to be added to the queue
-                    continue;
-                }
-
-                // Process the next request in the queue
-                status = Status::BUSY;
-                auto request = request_queue.front();
-                request_queue.pop();
-                lock.unlock(); // Release the lock before simulating I/O
+        std::lock_guard<std::mutex> guard(lifecycle);
+        if (run_state.load(std::memory_order_relaxed) != RunState::STOPPED) return;
 
-                // Simulate I/O time based on data size
-                std::this_thread::sleep_for(
-                    std::chrono::milliseconds(request.data_size / 1024)
-                );
-            }
-        }).detach();
+        live_workers = worker_count;
+        run_state.store(RunState::RUNNING, std::memory_order_release);
+        worker_threads.reserve(worker_count);
+        for (size_t i = 0; i < worker_count; ++i) {
+            worker_threads.emplace_back([this, i]() { worker_loop(i); });
+        }
     }
 
     /**
      * Stop Processing
      * --------------
-     * Gracefully stops the request processing thread.
+     * Stops admitting requests and shuts the workers down:
+     * - DRAIN waits for every admitted request to complete; if that takes
+     *   longer than `timeout` it escalates to CANCEL
+     * - CANCEL lets each worker finish its in-flight command (simulated
+     *   commands are at most COMMAND_OVERHEAD + 128 ms), then fails the rest
+     *
+     * Every thread is joined before returning, and any request still
+     * queued is completed with success == false, so no waiter is left
+     * hanging. Submission is open again once stop() returns.
+     * @param mode DRAIN or CANCEL
+     * @param timeout Upper bound on the drain phase
+     * @return Number of requests cancelled
      */
+    size_t stop(StopMode mode = StopMode::DRAIN,
+                std::chrono::milliseconds timeout = DEFAULT_STOP_TIMEOUT) {
+        std::lock_guard<std::mutex> guard(lifecycle);
+        if (run_state.load(std::memory_order_relaxed) == RunState::RUNNING) {
+            run_state.store(mode == StopMode::DRAIN ? RunState::DRAINING : RunState::CANCELLING,
+                            std::memory_order_release);
+            waiter.notify_all();  // Wake up any waiting threads
+
+            if (mode == StopMode::DRAIN) {
+                std::unique_lock<std::mutex> lock(exit_mutex);
+                if (!exit_cv.wait_for(lock, timeout, [this] { return live_workers == 0; })) {
+                    run_state.store(RunState::CANCELLING, std::memory_order_release);
+                    lock.unlock();
+                    waiter.notify_all();
+                }
+            }
+            for (std::thread& thread : worker_threads) thread.join();
+            worker_threads.clear();
+        } else if (run_state.load(std::memory_order_relaxed) == RunState::STOPPED) {
+            if (mode == StopMode::DRAIN) return 0;  // Never started: keep the queue for start
+            run_state.store(RunState::CANCELLING, std::memory_order_release);
+        }
+
+        size_t cancelled = cancel_queued();
+        run_state.store(RunState::STOPPED, std::memory_order_release);
+        return cancelled;
+    }
+
     void stop_processing() {
-        processing = false;
-        cv.notify_all();  // Wake up any waiting threads
+        stop(StopMode::DRAIN);
+    }
+
+    bool is_running() const {
+        return run_state.load(std::memory_order_acquire) == RunState::RUNNING;
     }
 
     /**
      * Status Queries
      * -------------
-     * Returns the current status of the device driver.
+     * Returns the current status of the device driver: ERROR if any worker
+     * is in error, BUSY if any is processing, READY otherwise.
      * @return The current device status (READY, BUSY, or ERROR).
      */
     Status get_status() const {
-        return status;
+        Status overall = Status::READY;
+        for (size_t i = 0; i < worker_count; ++i) {
+            Status status = workers[i].status.load(std::memory_order_relaxed);
+            if (status == Status::ERROR) return Status::ERROR;
+            if (status == Status::BUSY) overall = Status::BUSY;
+        }
+        return overall;
+    }
+
+    /**
+     * Scheduler Selection
+     * ------------------
+     * Switches every worker's queue to a new policy; queued requests are
+     * re-ordered in place.
+     */
+    void set_scheduler(Scheduler policy) {
+        scheduler.store(policy, std::memory_order_relaxed);
+        for (size_t i = 0; i < worker_count; ++i) {
+            std::lock_guard<std::mutex> lock(workers[i].mutex);
+            workers[i].queue.set_policy(policy);
+        }
+    }
+
+    Scheduler get_scheduler() const {
+        return scheduler.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Backend Selection
+     * ----------------
+     * Switches where requests are executed; takes effect from each
+     * worker's next command. Commands already running finish on the
+     * previous backend.
+     * @param path File or block device to read and write; created if missing
+     * @param use_uring Try io_uring first, otherwise use pread/pwrite
+     * @throws std::system_error if the file cannot be opened
+     */
+    void use_file_backend(const std::string& path, bool use_uring = true) {
+        std::atomic_store(&file_backend, std::make_shared<FileBackend>(path, use_uring));
+    }
+
+    void use_simulated_backend() {
+        std::atomic_store(&file_backend, std::shared_ptr<FileBackend>());
+    }
+
+    Backend get_backend() const {
+        return std::atomic_load(&file_backend) ? Backend::FILE_IO : Backend::SIMULATED;
+    }
+
+    /**
+     * Payload Pool
+     * -----------
+     * Sets the pool that submit_payload() blocks come from. Workers free
+     * completed payloads from their own threads, so the pool must be
+     * Concurrency::CONCURRENT. With the file backend the pool's region is
+     * registered as an io_uring fixed buffer, and the pool stays pinned
+     * (trim() releases nothing) while any worker's ring holds it.
+     * @throws std::invalid_argument if the pool is single-threaded
+     */
+    void set_payload_pool(MemoryPool& pool) {
+        if (pool.concurrency_mode() != MemoryPool::Concurrency::CONCURRENT) {
+            throw std::invalid_argument("Payload pool must be a concurrent MemoryPool");
+        }
+        payload_pool.store(&pool, std::memory_order_release);
+    }
+
+    /**
+     * Request Merging
+     * --------------
+     * When enabled, a worker folds requests queued directly behind the one
+     * it dispatches into a single device command if they have the same
+     * operation and priority and continue its byte range, up to
+     * MAX_MERGE_SIZE bytes.
+     */
+    void set_merging(bool enabled) {
+        merging.store(enabled, std::memory_order_relaxed);
+    }
+
+    bool get_merging() const {
+        return merging.load(std::memory_order_relaxed);
+    }
+
+    static const char* scheduler_name(Scheduler policy) {
+        return IoScheduler<DeviceRequest>::policy_name(policy);
+    }
+
+    /**
+     * Per-Worker Status
+     * ----------------
+     * @param index Worker number (0..worker_count-1)
+     */
+    Status get_worker_status(size_t index) const {
+        return workers[index % worker_count].status.load(std::memory_order_relaxed);
+    }
+
+    size_t get_worker_count() const {
+        return worker_count;
     }
 
     /**
      * Queue Size
      * ----------
-     * Returns the current number of requests in the queue.
+     * Returns the current number of requests waiting in the shared ring
+     * or in worker queues, or being processed.
      * @return The number of requests in the queue.
      */
     size_t queue_size() const {
-        std::lock_guard<std::mutex> lock(mutex);
-        return request_queue.size();
+        return outstanding.load(std::memory_order_relaxed);
+    }
+
+    static const char* status_name(Status status) {
+        switch (status) {
+            case Status::READY: return "READY";
+            case Status::BUSY: return "BUSY";
+            case Status::ERROR: return "ERROR";
+            default: return "UNKNOWN";
+        }
+    }
+
+    /**
+     * Metrics Export
+     * -------------
+     * Appends submit/reject/completion counters, the current queue depth
+     * and the depth, wait time and service time histograms to a snapshot
+     */
+    void export_metrics(MetricsWriter& writer) const {
+        uint64_t completed = 0, dispatched = 0, failed = 0, stolen = 0;
+        for (size_t i = 0; i < worker_count; ++i) {
+            completed += workers[i].completed.load(std::memory_order_relaxed);
+            dispatched += workers[i].dispatched.load(std::memory_order_relaxed);
+            failed += workers[i].failed.load(std::memory_order_relaxed);
+            stolen += workers[i].stolen.load(std::memory_order_relaxed);
+        }
+
+        writer.counter("device_submitted_total", "Requests admitted to the queue.", submitted.value(0));
+        writer.counter("device_rejected_total", "Submits refused because the queue was full or stopping.",
+                       rejected.value(0));
+        writer.counter("device_completed_total", "Requests completed by workers.", completed);
+        writer.counter("device_failed_total", "Requests completed with an I/O error.", failed);
+        writer.counter("device_commands_total", "Device commands issued after merging.", dispatched);
+        writer.counter("device_stolen_total", "Requests moved between workers by stealing.", stolen);
+        writer.gauge("device_queue_depth", "Requests queued or in flight.", static_cast<double>(queue_size()));
+        writer.histogram("device_queue_depth_at_submit", "Queue depth seen by each admitted request.",
+                         queue_depth.snapshot());
+        writer.histogram("device_wait_time_ns", "Submission to dispatch in nanoseconds.", wait_time.snapshot());
+        writer.histogram("device_service_time_ns", "Dispatch to completion in nanoseconds.",
+                         service_time.snapshot());
     }
 
     /**
      * Statistics Display
      * -----------------
-     * Prints the current device status and queue size to the console.
+     * Prints the current device status, queue size, merge ratio and per-worker
+     * status/throughput to the console.
      */
     void print_stats() const {
-        std::lock_guard<std::mutex> lock(mutex);
         std::cout << "Device Driver Stats:\n"
-                  << "Status: " << static_cast<int>(status) << "\n"
-                  << "Queue Size: " << request_queue.size() << "/"
-                  << MAX_QUEUE_SIZE << "\n";
+                  << "Status: " << status_name(get_status()) << "\n"
+                  << "Queue Size: " << queue_size() << "/"
+                  << MAX_QUEUE_SIZE << "\n"
+                  << "Scheduler: " << scheduler_name(get_scheduler()) << "\n";
+
+        auto backend = std::atomic_load(&file_backend);
+        std::cout << "Backend: ";
+        if (backend) std::cout << "file " << backend->path() << " (" << backend->engine_name() << ")\n";
+        else std::cout << "simulated\n";
+
+        size_t completed = 0, dispatched = 0;
+        for (size_t i = 0; i < worker_count; ++i) {
+            completed += workers[i].completed.load(std::memory_order_relaxed);
+            dispatched += workers[i].dispatched.load(std::memory_order_relaxed);
+        }
+        std::cout << "Merging: " << (get_merging() ? "on" : "off")
+                  << ", merge ratio " << (dispatched ? static_cast<double>(completed) / dispatched : 1.0)
+                  << " (" << completed << " requests in " << dispatched << " commands)\n"
+                  << "Workers: " << worker_count << "\n";
+        for (size_t i = 0; i < worker_count; ++i) {
+            const Worker& worker = workers[i];
+            std::cout << "  Worker " << i << ": status "
+                      << status_name(worker.status.load(std::memory_order_relaxed))
+                      << ", completed " << worker.completed.load(std::memory_order_relaxed)
+                      << ", stolen " << worker.stolen.load(std::memory_order_relaxed)
+                      << ", failed " << worker.failed.load(std::memory_order_relaxed) << "\n";
+        }
     }
 };
\ No newline at end of file
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ * Extent Tree
+ * ----------
+ * Max tree over fixed-size address chunks of a memory pool. Each leaf holds
+ * the largest free block starting in its chunk; each inner node the maximum
+ * of its children:
+ *
+ * I. Concepts Demonstrated:
+ * 1. Incremental Aggregation
+ *    - The root is the largest free extent, read in O(1)
+ *    - A change climbs only until an ancestor already reflects it
+ *
+ * 2. Address-Ordered Search
+ *    - find() returns the lowest chunk holding a large enough extent, the
+ *      chunk where a first-fit scan would stop
+ *
+ * 3. Cache-Conscious Layout
+ *    - FANOUT 32-bit entries per node fill one 64-byte cache line, so a
+ *      1M-leaf tree is five nodes deep instead of twenty
+ *
+ * Implementation Notes:
+ * - Levels are stored bottom-up in one array; each level is padded to a
+ *   whole number of nodes with zero entries
+ * - Values are caller-defined units (MemoryPool uses ALIGNMENT-sized units)
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class ExtentTree {
+public:
+    static constexpr size_t FANOUT = 16;
+
+private:
+    std::vector<uint32_t> entries;    // All levels, leaves first
+    std::vector<size_t> level_start;  // Offset of each level in entries
+    size_t leaf_count = 0;
+
+    size_t levels() const { return level_start.size(); }
+
+    size_t level_width(size_t level) const {
+        size_t end = level + 1 < levels() ? level_start[level + 1] : entries.size();
+        return end - level_start[level];
+    }
+
+    uint32_t& at(size_t level, size_t index) { return entries[level_start[level] + index]; }
+    const uint32_t& at(size_t level, size_t index) const { return entries[level_start[level] + index]; }
+
+public:
+    explicit ExtentTree(size_t leaves = 0) {
+        reset(leaves);
+    }
+
+    /**
+     * Reset
+     * ----
+     * Resizes to `leaves` leaves, all zero
+     */
+    void reset(size_t leaves) {
+        leaf_count = leaves;
+        level_start.clear();
+        size_t width = leaves ? leaves : 1, offset = 0;
+        for (;;) {
+            size_t padded = (width + FANOUT - 1) / FANOUT * FANOUT;
+            level_start.push_back(offset);
+            offset += padded;
+            if (width == 1) break;
+            width = padded / FANOUT;
+        }
+        entries.assign(offset, 0);
+    }
+
+    /**
+     * Resize
+     * -----
+     * Keeps existing leaves (new ones start at zero) and rebuilds every
+     * inner node; O(leaves), so callers grow geometrically
+     */
+    void resize(size_t leaves) {
+        std::vector<uint32_t> kept(entries.begin(), entries.begin() + std::min(leaf_count, leaves));
+        reset(leaves);
+        std::copy(kept.begin(), kept.end(), entries.begin());
+        for (size_t level = 0; level + 1 < levels(); ++level) {
+            for (size_t node = 0; node < level_width(level) / FANOUT; ++node) {
+                const uint32_t* group = &at(level, node * FANOUT);
+                at(level + 1, node) = *std::max_element(group, group + FANOUT);
+            }
+        }
+    }
+
+    size_t size() const { return leaf_count; }
+    uint32_t max() const { return at(levels() - 1, 0); }
+    uint32_t get(size_t leaf) const { return at(0, leaf); }
+
+    /**
+     * Exact Update
+     * -----------
+     * Sets a leaf and recomputes ancestors until one is unchanged
+     */
+    void set(size_t leaf, uint32_t value) {
+        at(0, leaf) = value;
+        size_t index = leaf;
+        for (size_t level = 0; level + 1 < levels(); ++level) {
+            size_t node = index / FANOUT;
+            const uint32_t* group = &at(level, node * FANOUT);
+            uint32_t largest = *std::max_element(group, group + FANOUT);
+            uint32_t& parent = at(level + 1, node);
+            if (parent == largest) return;
+            parent = largest;
+            index = node;
+        }
+    }
+
+    /**
+     * Monotonic Update
+     * ---------------
+     * Raises a leaf to at least `value`; never lowers anything
+     */
+    void raise(size_t leaf, uint32_t value) {
+        size_t index = leaf;
+        for (size_t level = 0; level < levels(); ++level, index /= FANOUT) {
+            uint32_t& entry = at(level, index);
+            if (entry >= value) return;
+            entry = value;
+        }
+    }
+
+    /**
+     * Search
+     * -----
+     * @param from: First leaf to consider
+     * @param at_least: Required value (> 0)
+     * @return: Lowest leaf >= from whose value is >= at_least, or size()
+     */
+    size_t find(size_t from, uint32_t at_least) const {
+        if (from >= leaf_count) return leaf_count;
+
+        // Scan the rest of the current node, else move right one level up
+        size_t level = 0, index = from;
+        for (;;) {
+            size_t end = (index / FANOUT + 1) * FANOUT;
+            const uint32_t* row = &at(level, 0);
+            while (index < end && row[index] < at_least) ++index;
+            if (index < end) break;
+            if (level + 1 == levels()) return leaf_count;
+            index = index / FANOUT;  // Next node to the right, one level up
+            ++level;
+            if (index >= level_width(level)) return leaf_count;
+        }
+
+        // Descend to the leftmost qualifying leaf
+        while (level > 0) {
+            --level;
+            index *= FANOUT;
+            const uint32_t* row = &at(level, 0);
+            while (row[index] < at_least) ++index;
+        }
+        return index;
+    }
+};
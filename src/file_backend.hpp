@@ -0,0 +1,457 @@
+/*******************************************************************************
+ * File I/O Backend
+ * ---------------
+ * Executes device requests against a real file or block device, so the
+ * driver can be used to study actual storage throughput:
+ *
+ * I. Concepts Demonstrated:
+ * 1. Asynchronous Submission (io_uring)
+ *    - Shared submission/completion rings mapped from the kernel
+ *    - A whole batch submitted and reaped with one io_uring_enter()
+ *    - Registered (fixed) buffers: pinned once, no per-I/O page mapping
+ *
+ * 2. Synchronous Fallback
+ *    - pread/pwrite when io_uring is unavailable (old kernel, seccomp)
+ *    - Concurrency then comes from the driver's worker threads, which act
+ *      as the I/O thread pool
+ *
+ * 3. Per-Queue Contexts
+ *    - One ring and buffer set per worker (like one NVMe queue pair per
+ *      CPU), so submission never takes a lock
+ *
+ * Implementation Notes:
+ * - Raw syscalls against <linux/io_uring.h>; no liburing dependency
+ * - Requests larger than BUFFER_SIZE are split into BUFFER_SIZE chunks
+ * - At most QUEUE_DEPTH chunks are in flight per context; longer batches
+ *   are submitted in rounds
+ * - Ops without a caller buffer use per-context scratch buffers, so their
+ *   data is not preserved; ops with a buffer read/write it in place
+ *   (fixed when it lies in the registered payload region)
+ * - Vectored ops (a merged command: one file range, several buffers) go
+ *   out as a single READV/WRITEV (preadv/pwritev) of any length
+ *
+ * Error Handling:
+ * - File open failure: std::system_error
+ * - Per-I/O failure: reported in the op's Result (success == false)
+ * - io_uring_enter failure: the round stops submitting, reaps everything
+ *   already in flight, and fails only the chunks that did not complete; if
+ *   even waiting fails, the ring (and its region registration) is closed
+ *   and the context falls back to pread/pwrite
+ ******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <system_error>
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+class FileBackend {
+public:
+    static constexpr size_t BUFFER_SIZE = 64 * 1024;   // Registered buffer (and chunk) size
+    static constexpr unsigned QUEUE_DEPTH = 8;         // Buffers and in-flight chunks per context
+    static constexpr size_t MAX_SEGMENTS = 32;         // Buffers in one vectored op
+
+    /**
+     * I/O Operation and Result
+     * -----------------------
+     */
+    struct Segment {
+        char* buffer;       // Caller's data, or nullptr for scratch
+        size_t length;      // Bytes of the op's range backed by this buffer
+    };
+
+    struct Op {
+        bool write;         // pwrite / WRITE_FIXED when true
+        uint64_t offset;    // Byte offset in the file
+        size_t length;      // Bytes to transfer
+        char* buffer;       // Caller's data (zero-copy), or nullptr for a scratch buffer
+        const Segment* segments = nullptr;  // Vectored op: buffers covering length, in order
+        size_t segment_count = 0;           // 0 for a plain op (uses buffer)
+    };
+
+    struct Result {
+        bool success;       // No chunk failed
+        size_t bytes;       // Bytes actually transferred (short at EOF)
+    };
+
+    /**
+     * Per-Worker Context
+     * -----------------
+     * Owns an io_uring instance (when available) and QUEUE_DEPTH registered
+     * scratch buffers, and optionally registers a caller region (a
+     * MemoryPool) as one more fixed buffer so payloads inside it go to the
+     * device without copies. Not thread-safe; one per worker.
+     */
+    class Context {
+        friend class FileBackend;
+
+        int ring_fd;                        // io_uring fd, or -1 for pread/pwrite
+        void* sq_map;                       // Submission ring mapping
+        size_t sq_map_size;
+        void* cq_map;                       // Completion ring mapping (may alias sq_map)
+        size_t cq_map_size;
+        io_uring_sqe* sqes;                 // Submission queue entries
+        size_t sqes_size;
+        unsigned* sq_tail;
+        unsigned* sq_mask;
+        unsigned* sq_array;
+        unsigned* cq_head;
+        unsigned* cq_tail;
+        unsigned* cq_mask;
+        io_uring_cqe* cqes;
+        char* buffers;                      // QUEUE_DEPTH * BUFFER_SIZE, page aligned
+        char* region;                       // Registered caller region (buffer index QUEUE_DEPTH)
+        size_t region_size;
+        std::atomic<size_t>* live_rings;    // Owning backend's count of live rings, while counted
+
+        static constexpr size_t BUFFER_ALIGN = 4096;
+
+        void setup_ring() {
+            io_uring_params params;
+            std::memset(&params, 0, sizeof(params));
+            int fd = static_cast<int>(syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params));
+            if (fd < 0) return;  // Fall back to pread/pwrite
+
+            sq_map_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+            cq_map_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+            bool single = params.features & IORING_FEAT_SINGLE_MMAP;
+            if (single && cq_map_size > sq_map_size) sq_map_size = cq_map_size;
+
+            sq_map = mmap(nullptr, sq_map_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          fd, IORING_OFF_SQ_RING);
+            cq_map = single ? sq_map
+                            : mmap(nullptr, cq_map_size, PROT_READ | PROT_WRITE,
+                                   MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_CQ_RING);
+            sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+            void* sqe_map = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE,
+                                 MAP_SHARED | MAP_POPULATE, fd, IORING_OFF_SQES);
+            if (sq_map == MAP_FAILED || cq_map == MAP_FAILED || sqe_map == MAP_FAILED) {
+                if (sqe_map != MAP_FAILED) munmap(sqe_map, sqes_size);
+                if (!single && cq_map != MAP_FAILED) munmap(cq_map, cq_map_size);
+                if (sq_map != MAP_FAILED) munmap(sq_map, sq_map_size);
+                sq_map = cq_map = nullptr;
+                close(fd);
+                return;
+            }
+
+            char* sq = static_cast<char*>(sq_map);
+            char* cq = static_cast<char*>(cq_map);
+            sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            sq_mask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            cq_mask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            sqes = static_cast<io_uring_sqe*>(sqe_map);
+            ring_fd = fd;
+
+            // Pin the buffers once so fixed reads/writes skip get_user_pages
+            iovec iov[QUEUE_DEPTH + 1];
+            for (unsigned i = 0; i < QUEUE_DEPTH; ++i) {
+                iov[i].iov_base = buffers + i * BUFFER_SIZE;
+                iov[i].iov_len = BUFFER_SIZE;
+            }
+            iov[QUEUE_DEPTH].iov_base = region;
+            iov[QUEUE_DEPTH].iov_len = region_size;
+            if (region &&
+                syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS, iov, QUEUE_DEPTH + 1) == 0) {
+                return;
+            }
+            region = nullptr;  // Payloads outside fixed buffers use plain READ/WRITE
+            region_size = 0;
+            if (syscall(__NR_io_uring_register, ring_fd, IORING_REGISTER_BUFFERS, iov, QUEUE_DEPTH) < 0) {
+                teardown_ring();
+            }
+        }
+
+        // Closing the ring also drops its buffer registration
+        void teardown_ring() {
+            if (ring_fd < 0) return;
+            munmap(sqes, sqes_size);
+            if (cq_map != sq_map) munmap(cq_map, cq_map_size);
+            munmap(sq_map, sq_map_size);
+            close(ring_fd);
+            ring_fd = -1;
+            region = nullptr;
+            region_size = 0;
+            if (live_rings) live_rings->fetch_sub(1, std::memory_order_relaxed);
+            live_rings = nullptr;
+        }
+
+    public:
+        /**
+         * @param use_uring: Try to set up an io_uring instance
+         * @param payload_region: Region to register for zero-copy payloads, or nullptr
+         * @param payload_size: Size of that region
+         */
+        Context(bool use_uring, char* payload_region, size_t payload_size)
+            : ring_fd(-1), sq_map(nullptr), sq_map_size(0), cq_map(nullptr), cq_map_size(0),
+              sqes(nullptr), sqes_size(0), sq_tail(nullptr), sq_mask(nullptr), sq_array(nullptr),
+              cq_head(nullptr), cq_tail(nullptr), cq_mask(nullptr), cqes(nullptr),
+              buffers(static_cast<char*>(::operator new(QUEUE_DEPTH * BUFFER_SIZE,
+                                                        std::align_val_t(BUFFER_ALIGN)))),
+              region(payload_region), region_size(payload_region ? payload_size : 0),
+              live_rings(nullptr) {
+            std::memset(buffers, 0, QUEUE_DEPTH * BUFFER_SIZE);
+            if (use_uring) setup_ring();
+        }
+
+        Context(const Context&) = delete;
+        Context& operator=(const Context&) = delete;
+
+        ~Context() {
+            teardown_ring();
+            ::operator delete(buffers, std::align_val_t(BUFFER_ALIGN));
+        }
+
+        bool uses_uring() const { return ring_fd >= 0; }
+        bool region_registered() const { return region != nullptr; }
+
+        bool in_region(const char* data, size_t length) const {
+            return region && data >= region && data + length <= region + region_size;
+        }
+    };
+
+private:
+    int file_fd;            // Target file or block device
+    std::string file_path;
+    bool prefer_uring;      // Try io_uring before falling back
+    mutable std::atomic<size_t> live_rings;  // Contexts whose ring is still open
+
+    /**
+     * Chunk Bookkeeping
+     * ----------------
+     * One entry per buffer slot in the current round; a vectored op is a
+     * single chunk whose iovecs live in the round's vector table
+     */
+    struct Chunk {
+        size_t op;          // Index into the caller's op array
+        size_t length;      // Bytes in this chunk
+        char* data;         // Payload slice, or nullptr for the slot's scratch buffer
+        iovec* vectors;     // Vectored op's buffers, or nullptr
+        unsigned vector_count;
+    };
+
+    static char* chunk_buffer(Context& ctx, const Chunk& chunk, unsigned slot) {
+        return chunk.data ? chunk.data : ctx.buffers + slot * BUFFER_SIZE;
+    }
+
+    /**
+     * Vector Preparation
+     * -----------------
+     * Scratch segments of a vectored op all alias the context's scratch
+     * area (their data is not preserved either way).
+     * @return False if the op has too many segments, a scratch segment
+     *         larger than the scratch area, or segments not summing to length
+     */
+    static bool prepare_vectors(Context& ctx, const Op& op, iovec* vectors) {
+        if (op.segment_count > MAX_SEGMENTS) return false;
+        size_t covered = 0;
+        for (size_t i = 0; i < op.segment_count; ++i) {
+            const Segment& segment = op.segments[i];
+            if (!segment.buffer && segment.length > QUEUE_DEPTH * BUFFER_SIZE) return false;
+            vectors[i].iov_base = segment.buffer ? segment.buffer : ctx.buffers;
+            vectors[i].iov_len = segment.length;
+            covered += segment.length;
+        }
+        return covered == op.length;
+    }
+
+    /**
+     * Round Execution
+     * --------------
+     * Issues `count` chunks, already bound to buffer slots 0..count-1, and
+     * waits for all of them; adds each chunk's outcome to its op's result
+     */
+    void run_uring(Context& ctx, const Op* ops, const Chunk* chunks, const uint64_t* offsets,
+                   unsigned count, Result* results) {
+        unsigned tail = *ctx.sq_tail;
+        for (unsigned slot = 0; slot < count; ++slot) {
+            unsigned index = tail & *ctx.sq_mask;
+            io_uring_sqe* sqe = &ctx.sqes[index];
+            const Chunk& chunk = chunks[slot];
+            bool write = ops[chunk.op].write;
+            std::memset(sqe, 0, sizeof(*sqe));
+            sqe->fd = file_fd;
+            sqe->addr = reinterpret_cast<uint64_t>(chunk_buffer(ctx, chunk, slot));
+            sqe->len = static_cast<uint32_t>(chunk.length);
+            sqe->off = offsets[slot];
+            if (chunk.vectors) {
+                sqe->opcode = write ? IORING_OP_WRITEV : IORING_OP_READV;
+                sqe->addr = reinterpret_cast<uint64_t>(chunk.vectors);
+                sqe->len = chunk.vector_count;
+            } else if (!chunk.data || ctx.in_region(chunk.data, chunk.length)) {
+                sqe->opcode = write ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+                sqe->buf_index = static_cast<uint16_t>(chunk.data ? QUEUE_DEPTH : slot);
+            } else {
+                sqe->opcode = write ? IORING_OP_WRITE : IORING_OP_READ;
+            }
+            sqe->user_data = slot;
+            ctx.sq_array[index] = index;
+            ++tail;
+        }
+        __atomic_store_n(ctx.sq_tail, tail, __ATOMIC_RELEASE);
+
+        // One syscall submits the round and waits for every completion. An
+        // error stops submission, but the round only ends once every SQE
+        // the kernel took has completed: their buffers and user_data slots
+        // are reused by the next round
+        bool completed[QUEUE_DEPTH] = {};
+        unsigned submitted = 0, reaped = 0;
+        bool aborted = false;  // Submitting no more; reaping what is in flight
+        while (aborted ? reaped < submitted : reaped < count) {
+            unsigned to_submit = aborted ? 0 : count - submitted;
+            unsigned to_wait = (aborted ? submitted : count) - reaped;
+            long rc = syscall(__NR_io_uring_enter, ctx.ring_fd, to_submit, to_wait,
+                              IORING_ENTER_GETEVENTS, nullptr, 0);
+            if (rc < 0) {
+                if (errno == EINTR) continue;
+                if (aborted) {
+                    // Cannot even wait: close the ring so nothing can touch
+                    // these buffers later; the context falls back to pread/pwrite
+                    ctx.teardown_ring();
+                    break;
+                }
+                aborted = true;
+                __atomic_store_n(ctx.sq_tail, tail - (count - submitted), __ATOMIC_RELEASE);  // Withdraw unsubmitted SQEs
+                continue;
+            }
+            submitted += static_cast<unsigned>(rc);
+
+            // Drain every available completion in one pass
+            unsigned head = *ctx.cq_head;
+            unsigned available = __atomic_load_n(ctx.cq_tail, __ATOMIC_ACQUIRE);
+            while (head != available) {
+                const io_uring_cqe& cqe = ctx.cqes[head & *ctx.cq_mask];
+                completed[cqe.user_data] = true;
+                Result& result = results[chunks[cqe.user_data].op];
+                if (cqe.res < 0) result.success = false;
+                else result.bytes += static_cast<size_t>(cqe.res);
+                ++head;
+                ++reaped;
+            }
+            __atomic_store_n(ctx.cq_head, head, __ATOMIC_RELEASE);
+        }
+
+        // Chunks that never completed fail their op, whatever order the rest finished in
+        for (unsigned slot = 0; slot < count; ++slot) {
+            if (!completed[slot]) results[chunks[slot].op].success = false;
+        }
+    }
+
+    void run_sync(Context& ctx, const Op* ops, const Chunk* chunks, const uint64_t* offsets,
+                  unsigned count, Result* results) {
+        for (unsigned slot = 0; slot < count; ++slot) {
+            const Op& op = ops[chunks[slot].op];
+            const Chunk& chunk = chunks[slot];
+            char* buffer = chunk_buffer(ctx, chunk, slot);
+            int vector_count = static_cast<int>(chunk.vector_count);
+            ssize_t rc = chunk.vectors
+                ? (op.write ? pwritev(file_fd, chunk.vectors, vector_count, static_cast<off_t>(offsets[slot]))
+                            : preadv(file_fd, chunk.vectors, vector_count, static_cast<off_t>(offsets[slot])))
+                : (op.write ? pwrite(file_fd, buffer, chunk.length, offsets[slot])
+                            : pread(file_fd, buffer, chunk.length, offsets[slot]));
+            Result& result = results[chunks[slot].op];
+            if (rc < 0) result.success = false;
+            else result.bytes += static_cast<size_t>(rc);
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param path: File or block device; created if missing
+     * @param use_uring: Try io_uring first (falls back automatically)
+     * @throws: std::system_error if the file cannot be opened
+     */
+    explicit FileBackend(const std::string& path, bool use_uring = true)
+        : file_fd(open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644)),
+          file_path(path), prefer_uring(use_uring), live_rings(0) {
+        if (file_fd < 0) {
+            throw std::system_error(errno, std::generic_category(), "open " + path);
+        }
+    }
+
+    FileBackend(const FileBackend&) = delete;
+    FileBackend& operator=(const FileBackend&) = delete;
+
+    ~FileBackend() {
+        close(file_fd);
+    }
+
+    std::unique_ptr<Context> make_context(char* payload_region = nullptr, size_t payload_size = 0) const {
+        auto context = std::make_unique<Context>(prefer_uring, payload_region, payload_size);
+        if (context->uses_uring()) {
+            live_rings.fetch_add(1, std::memory_order_relaxed);
+            context->live_rings = &live_rings;
+        }
+        return context;
+    }
+
+    /**
+     * Batch Execution
+     * --------------
+     * Performs every op, QUEUE_DEPTH chunks per round, and fills results[i]
+     * for ops[i]. A vectored op takes one chunk (one SQE) whatever its
+     * length; a malformed one fails without being issued.
+     */
+    void execute(Context& ctx, const Op* ops, size_t count, Result* results) {
+        for (size_t i = 0; i < count; ++i) results[i] = Result{true, 0};
+
+        Chunk chunks[QUEUE_DEPTH];
+        uint64_t offsets[QUEUE_DEPTH];
+        iovec vectors[QUEUE_DEPTH][MAX_SEGMENTS];
+        size_t op = 0, done = 0;   // Next op and bytes of it already issued
+        while (op < count) {
+            unsigned slots = 0;
+            while (slots < QUEUE_DEPTH && op < count) {
+                if (ops[op].segment_count > 0) {
+                    if (prepare_vectors(ctx, ops[op], vectors[slots])) {
+                        chunks[slots] = Chunk{op, ops[op].length, nullptr, vectors[slots],
+                                              static_cast<unsigned>(ops[op].segment_count)};
+                        offsets[slots] = ops[op].offset;
+                        ++slots;
+                    } else {
+                        results[op].success = false;
+                    }
+                    ++op;
+                    continue;
+                }
+                size_t remaining = ops[op].length - done;
+                size_t length = remaining < BUFFER_SIZE ? remaining : BUFFER_SIZE;
+                chunks[slots] = Chunk{op, length, ops[op].buffer ? ops[op].buffer + done : nullptr,
+                                      nullptr, 0};
+                offsets[slots] = ops[op].offset + done;
+                ++slots;
+                done += length;
+                if (done >= ops[op].length) {
+                    ++op;
+                    done = 0;
+                }
+            }
+            if (slots == 0) break;
+            if (ctx.uses_uring()) run_uring(ctx, ops, chunks, offsets, slots, results);
+            else run_sync(ctx, ops, chunks, offsets, slots, results);
+        }
+    }
+
+    const std::string& path() const { return file_path; }
+
+    // io_uring while any context still has its ring open
+    const char* engine_name() const {
+        return live_rings.load(std::memory_order_relaxed) > 0 ? "io_uring" : "pread/pwrite";
+    }
+};
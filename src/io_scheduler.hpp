@@ -0,0 +1,209 @@
+/*******************************************************************************
+ * I/O Scheduler
+ * ------------
+ * Per-queue request ordering for the device driver, modelled on the Linux
+ * block layer's elevators:
+ *
+ * I. Scheduling Policies:
+ * 1. FIFO
+ *    - Submission order (noop / none)
+ *
+ * 2. Deadline
+ *    - Earliest expiry first; reads expire sooner than writes, so a small
+ *      read is not stuck behind a long run of writes (mq-deadline)
+ *
+ * 3. Shortest Job First
+ *    - Smallest data_size first; minimizes mean wait, may starve large I/O
+ *
+ * 4. Priority
+ *    - Per-request class (real-time, best-effort, idle), FIFO within a class
+ *      (like ioprio classes under BFQ)
+ *
+ * Implementation Notes:
+ * - Binary min-heap of (primary, secondary) keys computed on insertion
+ * - secondary is a per-queue arrival counter, so equal keys stay FIFO
+ * - Changing policy re-keys and re-heapifies the queued requests
+ * - Stealing takes entries off the end of the heap array: truncating a heap
+ *   keeps it a heap, and those are leaves, i.e. the least urgent half
+ * - Not synchronized; the driver guards each queue with its worker's mutex
+ *
+ * Request Requirements:
+ *   timestamp (steady_clock::time_point), data_size, priority (IoPriority),
+ *   bool is_read() const
+ ******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <vector>
+
+/**
+ * Scheduling Policy Selection
+ * --------------------------
+ */
+enum class SchedulerPolicy {
+    FIFO,       // Submission order
+    DEADLINE,   // Earliest deadline first
+    SJF,        // Shortest job first
+    PRIORITY    // Priority class, then submission order
+};
+
+/**
+ * Request Priority Classes
+ * -----------------------
+ * Lower value is served first under SchedulerPolicy::PRIORITY
+ */
+enum class IoPriority : uint8_t {
+    REALTIME,
+    BEST_EFFORT,
+    IDLE
+};
+
+template <typename Request>
+class IoScheduler {
+public:
+    static constexpr std::chrono::milliseconds READ_EXPIRE{500};    // mq-deadline read_expire
+    static constexpr std::chrono::milliseconds WRITE_EXPIRE{5000};  // mq-deadline write_expire
+
+private:
+    struct Entry {
+        uint64_t primary;     // Policy-dependent sort key
+        uint64_t secondary;   // Arrival order tie-break
+        Request request;
+    };
+
+    std::vector<Entry> heap;    // Min-heap on (primary, secondary)
+    SchedulerPolicy policy_;    // Active ordering
+    uint64_t arrivals;          // Arrival counter for tie-breaks
+
+    // std heap algorithms build a max-heap; invert for earliest-first
+    static bool later(const Entry& a, const Entry& b) {
+        return a.primary != b.primary ? a.primary > b.primary : a.secondary > b.secondary;
+    }
+
+    static uint64_t ticks(std::chrono::steady_clock::time_point time) {
+        return static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count());
+    }
+
+    uint64_t key_for(const Request& request) const {
+        switch (policy_) {
+            case SchedulerPolicy::DEADLINE:
+                return ticks(request.timestamp + (request.is_read() ? READ_EXPIRE : WRITE_EXPIRE));
+            case SchedulerPolicy::SJF:
+                return request.data_size;
+            case SchedulerPolicy::PRIORITY:
+                return static_cast<uint64_t>(request.priority);
+            case SchedulerPolicy::FIFO:
+            default:
+                return ticks(request.timestamp);
+        }
+    }
+
+public:
+    /**
+     * Heap Insertion Iterator
+     * ----------------------
+     * Output iterator so bulk sources (MpmcRingBuffer::try_pop_bulk) can
+     * feed the scheduler directly
+     */
+    class Inserter {
+        IoScheduler* target;
+
+    public:
+        using iterator_category = std::output_iterator_tag;
+        using value_type = void;
+        using difference_type = void;
+        using pointer = void;
+        using reference = void;
+
+        explicit Inserter(IoScheduler& scheduler) : target(&scheduler) {}
+        Inserter& operator=(Request&& request) {
+            target->push(std::move(request));
+            return *this;
+        }
+        Inserter& operator*() { return *this; }
+        Inserter& operator++() { return *this; }
+        Inserter& operator++(int) { return *this; }
+    };
+
+    explicit IoScheduler(SchedulerPolicy policy = SchedulerPolicy::FIFO)
+        : policy_(policy), arrivals(0) {}
+
+    /**
+     * Queue Operations
+     * ---------------
+     * push/pop are O(log n)
+     */
+    void push(Request&& request) {
+        uint64_t primary = key_for(request);
+        heap.push_back(Entry{primary, arrivals++, std::move(request)});
+        std::push_heap(heap.begin(), heap.end(), later);
+    }
+
+    Inserter inserter() { return Inserter(*this); }
+
+    std::optional<Request> pop() {
+        if (heap.empty()) return std::nullopt;
+        std::pop_heap(heap.begin(), heap.end(), later);
+        std::optional<Request> request(std::move(heap.back().request));
+        heap.pop_back();
+        return request;
+    }
+
+    /**
+     * Next Request
+     * -----------
+     * @return: The request pop() would return, or nullptr when empty
+     */
+    const Request* top() const {
+        return heap.empty() ? nullptr : &heap.front().request;
+    }
+
+    /**
+     * Work Stealing
+     * ------------
+     * Moves half of this queue (rounded up) into `thief`, re-keyed under
+     * the thief's policy.
+     * @return: Number of requests moved
+     */
+    size_t steal_half(IoScheduler& thief) {
+        size_t take = (heap.size() + 1) / 2;
+        for (size_t i = 0; i < take; ++i) {
+            thief.push(std::move(heap.back().request));
+            heap.pop_back();
+        }
+        return take;
+    }
+
+    /**
+     * Policy Control
+     * -------------
+     * Re-keys every queued request under the new policy
+     */
+    void set_policy(SchedulerPolicy policy) {
+        if (policy == policy_) return;
+        policy_ = policy;
+        for (Entry& entry : heap) entry.primary = key_for(entry.request);
+        std::make_heap(heap.begin(), heap.end(), later);
+    }
+
+    SchedulerPolicy policy() const { return policy_; }
+    size_t size() const { return heap.size(); }
+    bool empty() const { return heap.empty(); }
+
+    static const char* policy_name(SchedulerPolicy policy) {
+        switch (policy) {
+            case SchedulerPolicy::FIFO: return "fifo";
+            case SchedulerPolicy::DEADLINE: return "deadline";
+            case SchedulerPolicy::SJF: return "sjf";
+            case SchedulerPolicy::PRIORITY: return "priority";
+            default: return "unknown";
+        }
+    }
+};
@@ -19,6 +19,12 @@
  *    - Level-based filtering
  *    - Buffered output
  *    - Minimal critical sections
+ *    - Optional asynchronous mode: per-thread SPSC record rings drained in
+ *      batches by a background writer thread (see spsc_ring.hpp)
+ *    - Timestamp text formatted once per second, not once per line
+ *    - LOG_* macros skip argument evaluation for disabled levels, and
+ *      levels below LOGGER_MIN_LEVEL are compiled out entirely
+ *    - "{}" format strings rendered into a reused per-thread buffer
  * 
  * II. Design Patterns:
  * 1. Singleton Pattern
@@ -44,20 +50,57 @@
  * 
  * Message Format:
  * [Timestamp] [Level] [Thread ID] Message
+ *
+ * Usage:
+ *   LOG_INFO(logger, "Allocated {} bytes at {}", size, ptr);
+ *   -DLOGGER_MIN_LEVEL=1 removes every LOG_DEBUG call at compile time
  * 
  * Performance Characteristics:
- * - Lock contention: Microsecond scale
- * - Memory overhead: Constant per message
+ * - Lock contention: Microsecond scale (synchronous), none (asynchronous)
+ * - Memory overhead: Constant per message; RING_RECORDS records per
+ *   logging thread in asynchronous mode
  * - CPU impact: Minimal (async I/O)
+ *
+ * Asynchronous Mode Notes:
+ * - A producer copies the message into its own ring and returns; it never
+ *   formats a timestamp, takes a lock or touches the output stream
+ * - Messages longer than one record span consecutive records, published
+ *   together, so lines are never interleaved
+ * - On a full ring, LOSSY drops the message (counted and reported as a
+ *   warning line), BLOCKING waits for the writer to make room
+ * - Output order is per-thread submission order; lines from different
+ *   threads are ordered by drain pass, not by timestamp
  ******************************************************************************/
 
 #pragma once
 #include <fstream>
 #include <string>
 #include <mutex>
+#include <condition_variable>
 #include <ctime>
 #include <sstream>
 #include <iostream>
+#include <atomic>
+#include <thread>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <charconv>
+#include <string_view>
+#include <type_traits>
+#include "spsc_ring.hpp"
+#include "wait_strategy.hpp"
+
+/**
+ * Compile-Time Level Floor
+ * -----------------------
+ * 0 = DEBUG, 1 = INFO, 2 = WARNING, 3 = ERROR. LOG_* calls below it
+ * compile to nothing.
+ */
+#ifndef LOGGER_MIN_LEVEL
+#define LOGGER_MIN_LEVEL 0
+#endif
 
 /**
  * Logger Class
@@ -108,31 +151,338 @@ public:
         ERROR     // Critical system problems
     };
 
+    /**
+     * Full-Buffer Policy (asynchronous mode)
+     * -------------------------------------
+     * - LOSSY:    Drop the message; never stall the caller
+     * - BLOCKING: Wait for the writer thread to free space
+     */
+    enum class Overflow {
+        LOSSY,
+        BLOCKING
+    };
+
+    static constexpr size_t RECORD_SIZE = 256;     // Bytes per ring record
+    static constexpr size_t RING_RECORDS = 512;    // Records per logging thread
+
 private:
+    /**
+     * Log Record
+     * ---------
+     * One fixed-size ring slot: the raw message text plus what the writer
+     * needs to format the line prefix
+     */
+    struct Record {
+        std::time_t seconds;    // Submission time, whole seconds
+        uint16_t length;        // Bytes used in text
+        uint8_t level;          // Level of the message
+        bool continued;         // Message continues in the next record
+        char text[RECORD_SIZE - sizeof(std::time_t) - 4];
+    };
+    static constexpr size_t TEXT_CAPACITY = sizeof(Record::text);
+
+    /**
+     * Per-Thread Buffer
+     * ----------------
+     * Owned jointly by the registry and the producing thread, so a thread
+     * can exit with records still queued
+     */
+    struct ProducerBuffer {
+        SpscRingBuffer<Record> ring{RING_RECORDS};  // Producer: owning thread; consumer: writer
+        std::atomic<size_t> written{0};             // Records the writer has flushed to output
+        std::atomic<bool> closed{false};            // Owning thread has exited
+    };
+
+    struct ProducerHandle {
+        std::shared_ptr<ProducerBuffer> buffer;
+        ~ProducerHandle() {
+            if (buffer) buffer->closed.store(true, std::memory_order_release);
+        }
+    };
+
+    /**
+     * Timestamp Cache
+     * --------------
+     * Re-runs localtime/strftime only when the second changes
+     */
+    struct TimestampCache {
+        std::time_t second = -1;
+        char text[32] = {};
+
+        const char* format(std::time_t now) {
+            if (now != second) {
+                std::tm tm;
+                localtime_r(&now, &tm);
+                std::strftime(text, sizeof(text), "%Y-%m-%d %H:%M:%S", &tm);
+                second = now;
+            }
+            return text;
+        }
+    };
+
     static Logger* instance;          // Singleton instance
     static std::mutex mutex;          // Thread synchronization
 
     std::ostream& output;            // Output stream (console/file)
-    Level min_level;                 // Minimum level to log
+    std::atomic<Level> min_level;    // Minimum level to log (runtime)
+    TimestampCache sync_stamp;       // Timestamp cache for synchronous lines (guarded by mutex)
+
+    std::atomic<bool> async_running;  // Producers enqueue instead of writing
+    std::atomic<bool> buffered;       // Synchronous lines end in '\n' instead of std::endl
+    std::atomic<Overflow> overflow;   // Full-ring policy
+    std::atomic<size_t> dropped_count;  // Messages lost to LOSSY overflow
+    size_t reported_drops;            // Drops already reported (writer-only)
+    std::mutex lifecycle;             // Serializes start_async/stop_async
+    std::thread writer;               // Background writer thread
+    AdaptiveWaiter waiter;            // Writer's spin-then-park wakeup
+    std::mutex registry_mutex;        // Guards producers
+    std::vector<std::shared_ptr<ProducerBuffer>> producers;  // Rings of every logging thread
+    std::mutex flush_mutex;           // Pairs with flush_cv
+    std::condition_variable flush_cv; // Signalled after each written batch
 
     /**
      * Private Constructor
      * ------------------
      * Prevents direct instantiation (Singleton pattern)
      */
-    Logger() : output(std::cout), min_level(Level::INFO) {}
+    Logger()
+        : output(std::cout), min_level(Level::INFO), async_running(false), buffered(false),
+          overflow(Overflow::LOSSY), dropped_count(0), reported_drops(0) {}
+
+    ~Logger() {
+        stop_async();
+    }
 
     /**
-     * Timestamp Generation
+     * Calling Thread's Buffer
+     * ----------------------
+     * Registered with the writer on the thread's first asynchronous message
+     */
+    ProducerBuffer& local_buffer() {
+        thread_local ProducerHandle handle;
+        if (!handle.buffer) {
+            handle.buffer = std::make_shared<ProducerBuffer>();
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            producers.push_back(handle.buffer);
+        }
+        return *handle.buffer;
+    }
+
+    void write_sync(Level level, std::string_view message) {
+        std::lock_guard<std::mutex> lock(mutex);  // Thread safety
+        output << "[" << sync_stamp.format(std::time(nullptr)) << "] "
+               << "[" << level_to_string(level) << "] ";
+        output.write(message.data(), static_cast<std::streamsize>(message.size()));
+        if (buffered.load(std::memory_order_relaxed)) output << '\n';
+        else output << std::endl;
+    }
+
+    /**
+     * Asynchronous Enqueue
      * -------------------
-     * Creates human-readable timestamps for log entries
+     * Copies the message into as many consecutive records as it needs
+     * (truncated to one full ring) and publishes them together
+     */
+    void write_async(Level level, std::string_view message) {
+        ProducerBuffer& buffer = local_buffer();
+        size_t length = message.size();
+        size_t chunks = length == 0 ? 1 : (length + TEXT_CAPACITY - 1) / TEXT_CAPACITY;
+        if (chunks > RING_RECORDS) {
+            chunks = RING_RECORDS;
+            length = RING_RECORDS * TEXT_CAPACITY;
+        }
+
+        while (buffer.ring.free_slots(chunks) < chunks) {
+            if (overflow.load(std::memory_order_relaxed) == Overflow::LOSSY) {
+                dropped_count.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            if (!async_running.load(std::memory_order_acquire)) {
+                write_sync(level, message);  // No writer left to make room
+                return;
+            }
+            waiter.notify_one();
+            std::this_thread::yield();
+        }
+
+        std::time_t now = std::time(nullptr);
+        for (size_t i = 0; i < chunks; ++i) {
+            Record* record = buffer.ring.back(i);
+            size_t begin = i * TEXT_CAPACITY;
+            size_t count = length - begin < TEXT_CAPACITY ? length - begin : TEXT_CAPACITY;
+            record->seconds = now;
+            record->length = static_cast<uint16_t>(count);
+            record->level = static_cast<uint8_t>(level);
+            record->continued = i + 1 < chunks;
+            std::memcpy(record->text, message.data() + begin, count);
+        }
+        buffer.ring.push(chunks);
+        waiter.notify_one();
+    }
+
+    void emit(Level level, std::string_view message) {
+        if (async_running.load(std::memory_order_relaxed)) {
+            write_async(level, message);
+        } else {
+            write_sync(level, message);
+        }
+    }
+
+    /**
+     * Argument Rendering
+     * -----------------
+     * Numbers via std::to_chars, strings appended as-is, pointers in hex;
+     * anything else through its operator<<
      */
-    static std::string get_timestamp() {
-        auto now = std::time(nullptr);
-        auto* tm = std::localtime(&now);
-        char buffer[32];
-        std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", tm);
-        return buffer;
+    template <typename T>
+    static void append_value(std::string& out, const T& value) {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>) {
+            out += value ? "true" : "false";
+        } else if constexpr (std::is_same_v<U, char>) {
+            out += value;
+        } else if constexpr (std::is_arithmetic_v<U>) {
+            char buffer[64];
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+            out.append(buffer, result.ptr);
+        } else if constexpr (std::is_enum_v<U>) {
+            append_value(out, static_cast<std::underlying_type_t<U>>(value));
+        } else if constexpr (std::is_same_v<T, const char*> || std::is_same_v<T, char*>) {
+            out += value ? value : "(null)";
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            out += std::string_view(value);
+        } else if constexpr (std::is_pointer_v<U>) {
+            char buffer[2 + 2 * sizeof(uintptr_t)] = {'0', 'x'};
+            auto result = std::to_chars(buffer + 2, buffer + sizeof(buffer),
+                                        reinterpret_cast<uintptr_t>(value), 16);
+            out.append(buffer, result.ptr);
+        } else {
+            std::ostringstream stream;
+            stream << value;
+            out += stream.str();
+        }
+    }
+
+    /**
+     * Format String Expansion
+     * ----------------------
+     * Each "{}" takes the next argument; "{{" and "}}" are literal braces.
+     * Surplus "{}" are kept verbatim, surplus arguments are ignored.
+     */
+    static void append_format(std::string& out, std::string_view format) {
+        size_t pos = 0;
+        while (pos < format.size()) {
+            size_t brace = format.find_first_of("{}", pos);
+            if (brace == std::string_view::npos) break;
+            out.append(format.data() + pos, brace - pos);
+            bool doubled = brace + 1 < format.size() && format[brace + 1] == format[brace];
+            out += format[brace];
+            pos = brace + (doubled ? 2 : 1);
+        }
+        if (pos < format.size()) out.append(format.data() + pos, format.size() - pos);
+    }
+
+    template <typename First, typename... Rest>
+    static void append_format(std::string& out, std::string_view format,
+                              const First& first, const Rest&... rest) {
+        size_t pos = 0;
+        while (pos < format.size()) {
+            size_t brace = format.find_first_of("{}", pos);
+            if (brace == std::string_view::npos) break;
+            out.append(format.data() + pos, brace - pos);
+            char next = brace + 1 < format.size() ? format[brace + 1] : '\0';
+            if (format[brace] == '{' && next == '}') {
+                append_value(out, first);
+                append_format(out, format.substr(brace + 2), rest...);
+                return;
+            }
+            out += format[brace];
+            pos = brace + (next == format[brace] ? 2 : 1);
+        }
+        if (pos < format.size()) out.append(format.data() + pos, format.size() - pos);
+    }
+
+    /**
+     * Writer Drain Pass
+     * ----------------
+     * Formats every queued record into one batch, writes and flushes it
+     * with a single stream call, then reports progress to flush() waiters.
+     * Rings of exited threads are dropped once empty.
+     * @return: Number of records written
+     */
+    size_t drain(std::string& batch, TimestampCache& stamp) {
+        size_t records = 0;
+        std::lock_guard<std::mutex> registry(registry_mutex);
+        for (auto it = producers.begin(); it != producers.end();) {
+            ProducerBuffer& buffer = **it;
+            bool closed = buffer.closed.load(std::memory_order_acquire);  // Before draining: no pushes follow
+            bool continuing = false;
+            while (const Record* record = buffer.ring.front()) {
+                if (!continuing) {
+                    batch += '[';
+                    batch += stamp.format(record->seconds);
+                    batch += "] [";
+                    batch += level_to_string(static_cast<Level>(record->level));
+                    batch += "] ";
+                }
+                batch.append(record->text, record->length);
+                continuing = record->continued;
+                if (!continuing) batch += '\n';
+                buffer.ring.pop();
+                ++records;
+            }
+            if (closed && buffer.ring.empty()) it = producers.erase(it);
+            else ++it;
+        }
+
+        size_t lost = dropped_count.load(std::memory_order_relaxed) - reported_drops;
+        reported_drops += lost;
+        if (lost) {
+            batch += '[';
+            batch += stamp.format(std::time(nullptr));
+            batch += "] [WARNING] Logger dropped " + std::to_string(lost) + " messages\n";
+        }
+        if (batch.empty()) return 0;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            output.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+            output.flush();
+        }
+        batch.clear();
+
+        for (auto& buffer : producers) {
+            buffer->written.store(buffer->ring.popped(), std::memory_order_release);
+        }
+        { std::lock_guard<std::mutex> lock(flush_mutex); }
+        flush_cv.notify_all();
+        return records ? records : 1;
+    }
+
+    bool pending() {
+        std::lock_guard<std::mutex> registry(registry_mutex);
+        for (auto& buffer : producers) {
+            if (!buffer->ring.empty()) return true;
+        }
+        return dropped_count.load(std::memory_order_relaxed) != reported_drops;
+    }
+
+    /**
+     * Writer Thread
+     * ------------
+     * Drains until stopped, then once more so nothing queued is lost
+     */
+    void writer_loop() {
+        std::string batch;
+        TimestampCache stamp;
+        for (;;) {
+            bool stopping = !async_running.load(std::memory_order_acquire);
+            if (drain(batch, stamp) != 0) continue;
+            if (stopping) break;
+            waiter.wait([this] {
+                return !async_running.load(std::memory_order_acquire) || pending();
+            });
+        }
     }
 
     /**
@@ -167,21 +517,117 @@ public:
      * Sets minimum level for message filtering
      */
     void set_min_level(Level level) {
-        min_level = level;
+        min_level.store(level, std::memory_order_relaxed);
+    }
+
+    /**
+     * Level Checks
+     * -----------
+     * compiled_in() is the LOGGER_MIN_LEVEL floor, usable in if constexpr;
+     * enabled() adds the runtime minimum
+     */
+    static constexpr bool compiled_in(Level level) {
+        return static_cast<int>(level) >= LOGGER_MIN_LEVEL;
+    }
+
+    bool enabled(Level level) const {
+        return compiled_in(level) && level >= min_level.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Asynchronous Mode Control
+     * ------------------------
+     * start_async() starts the writer thread; from then on log() only
+     * enqueues. stop_async() writes out everything queued, joins the
+     * writer and returns to synchronous output. Both are idempotent.
+     */
+    void start_async(Overflow policy = Overflow::LOSSY) {
+        std::lock_guard<std::mutex> guard(lifecycle);
+        overflow.store(policy, std::memory_order_relaxed);
+        if (async_running.load(std::memory_order_relaxed)) return;
+        async_running.store(true, std::memory_order_release);
+        writer = std::thread([this] { writer_loop(); });
+    }
+
+    void stop_async() {
+        std::lock_guard<std::mutex> guard(lifecycle);
+        if (!async_running.load(std::memory_order_relaxed)) return;
+        async_running.store(false, std::memory_order_release);
+        waiter.notify_all();
+        writer.join();
+        { std::lock_guard<std::mutex> lock(flush_mutex); }
+        flush_cv.notify_all();
+    }
+
+    bool is_async() const { return async_running.load(std::memory_order_acquire); }
+
+    /**
+     * Flush
+     * -----
+     * Returns once every message this thread logged has been written.
+     * Immediate in synchronous mode.
+     */
+    void flush() {
+        if (!is_async()) return;
+        ProducerBuffer& buffer = local_buffer();
+        size_t target = buffer.ring.pushed();
+        waiter.notify_one();
+        std::unique_lock<std::mutex> lock(flush_mutex);
+        flush_cv.wait(lock, [&] {
+            return buffer.written.load(std::memory_order_acquire) >= target || !is_async();
+        });
+    }
+
+    /**
+     * Buffered Output
+     * --------------
+     * While enabled, synchronous lines are not flushed one by one; batch
+     * callers (script mode) call flush_output() once per batch instead.
+     */
+    void set_buffered_output(bool enable) { buffered.store(enable, std::memory_order_relaxed); }
+    bool buffered_output() const { return buffered.load(std::memory_order_relaxed); }
+
+    /**
+     * Output Flush
+     * -----------
+     * flush(), then pushes the output stream itself to its destination
+     */
+    void flush_output() {
+        flush();
+        std::lock_guard<std::mutex> lock(mutex);
+        output.flush();
     }
 
+    /**
+     * Total messages dropped by LOSSY overflow
+     */
+    size_t dropped() const { return dropped_count.load(std::memory_order_relaxed); }
+
     /**
      * Generic Logging Method
      * ---------------------
-     * Thread-safe logging with level filtering
+     * Thread-safe logging with level filtering; enqueues in asynchronous
+     * mode and writes under the logger mutex otherwise
      */
     void log(Level level, const std::string& message) {
-        if (level < min_level) return;  // Level filtering
+        if (!enabled(level)) return;  // Level filtering
+        emit(level, message);
+    }
 
-        std::lock_guard<std::mutex> lock(mutex);  // Thread safety
-        output << "[" << get_timestamp() << "] "
-               << "[" << level_to_string(level) << "] "
-               << message << std::endl;
+    /**
+     * Formatted Logging
+     * ----------------
+     * Expands "{}" placeholders into a per-thread buffer that keeps its
+     * capacity between calls, so steady-state logging does not allocate.
+     * Prefer the LOG_* macros, which also skip evaluating the arguments.
+     */
+    template <typename... Args>
+    void logf(Level level, std::string_view format, const Args&... args) {
+        if (!enabled(level)) return;
+        thread_local std::string scratch;
+        scratch.clear();
+        append_format(scratch, format, args...);
+        emit(level, scratch);
     }
 
     /**
@@ -207,4 +653,23 @@ public:
 };
 
 // Initialize static mutex
-std::mutex Logger::mutex;
\ No newline at end of file
+std::mutex Logger::mutex;
+
+/**
+ * Logging Macros
+ * -------------
+ * LOG_INFO(logger, "format {}", args...): when the level is disabled the
+ * arguments are never evaluated; below LOGGER_MIN_LEVEL the statement is
+ * discarded at compile time.
+ */
+#define LOG_AT(logger, level, ...)                                          \
+    do {                                                                    \
+        if constexpr (Logger::compiled_in(level)) {                         \
+            if ((logger).enabled(level)) (logger).logf((level), __VA_ARGS__); \
+        }                                                                   \
+    } while (0)
+
+#define LOG_DEBUG(logger, ...) LOG_AT(logger, Logger::Level::DEBUG, __VA_ARGS__)
+#define LOG_INFO(logger, ...) LOG_AT(logger, Logger::Level::INFO, __VA_ARGS__)
+#define LOG_WARNING(logger, ...) LOG_AT(logger, Logger::Level::WARNING, __VA_ARGS__)
+#define LOG_ERROR(logger, ...) LOG_AT(logger, Logger::Level::ERROR, __VA_ARGS__)
\ No newline at end of file
@@ -10,15 +10,19 @@
  * 2. Exception handling for system-level operations
  * 3. Command-line argument processing
  * 4. Test mode vs interactive mode operation
+ * 5. Trace replay mode: --replay <trace> [fast|timed] [threads]
+ * 6. Script mode: --script <file>, or commands piped on stdin
  ******************************************************************************/
 
 #include "memory_pool.hpp"
 #include "device_driver.hpp"
 #include "logger.hpp"
 #include "cli.hpp"
+#include <fstream>
 #include <iostream>
 #include <vector>
 #include <string>
+#include <unistd.h>
 
 /**
  * Executes a predefined sequence of test commands
@@ -33,6 +37,13 @@ void run_test_sequence(CLI& cli) {
         "allocate 512",       // Fragment creation
         "allocate 256",       // Further fragmentation
         "stats",              // View fragmentation pattern
+
+        // Compaction Scenario
+        "allocate 4096 @1 movable",  // Relocatable blocks
+        "allocate 2048 @2 movable",
+        "allocate 128 @3",           // Fixed block behind them
+        "free @1",                   // Hole in front of a movable block
+        "compact",                   // Slide @2 down over the hole
         
         // Producer-Consumer Pattern Demo
         "submit read 512",    // Queue population
@@ -41,7 +52,8 @@ void run_test_sequence(CLI& cli) {
         "stats",              // Queue state verification
         
         // Error Handling Scenarios
-        "allocate 1048576",   // Memory exhaustion test
+        "allocate 1048576",   // Pool growth into the reservation
+        "allocate 134217728", // Memory exhaustion test (beyond the reservation)
         "submit write 2048",  // Large I/O test
         
         // Performance Load Test
@@ -49,6 +61,7 @@ void run_test_sequence(CLI& cli) {
         "submit write 128",
         "submit read 128",
         "stats",              // System under load stats
+        "trim 0",             // Return free pages to the OS
         "exit"                // Clean shutdown
     };
 
@@ -87,15 +100,38 @@ void run_test_sequence(CLI& cli) {
  * Operating Modes:
  * - Interactive: User command processing
  * - Test: Automated test sequence execution
+ * - Replay: Recorded workload trace execution
+ * - Script: Batch command execution from a file or pipe
  */
 int main(int argc, char* argv[]) {
     try {
         // System Initialization Phase
         // --------------------------
         
-        // Create a 1MB memory pool to demonstrate memory management
-        constexpr size_t POOL_SIZE = 1024 * 1024; // 1MB memory pool
-        MemoryPool memory_pool(POOL_SIZE);
+        // Determine operation mode (test, replay, script or interactive);
+        // stdin that is not a terminal runs as a script
+        bool test_mode = (argc > 1 && std::string(argv[1]) == "--test");
+        bool replay_mode = (argc > 2 && std::string(argv[1]) == "--replay");
+        bool script_mode = (argc > 2 && std::string(argv[1]) == "--script");
+        bool piped_mode = (argc == 1 && !isatty(STDIN_FILENO));
+        std::string replay_command;
+        size_t replay_threads = 1;
+        if (replay_mode) {
+            replay_command = "trace replay";
+            for (int i = 2; i < argc; ++i) replay_command += std::string(" ") + argv[i];
+            if (argc > 4) replay_threads = std::stoull(argv[4]);
+        }
+
+        // Create a 1MB memory pool to demonstrate memory management, able
+        // to grow into a 64MB reservation; parallel replay shares it
+        // between threads
+        constexpr size_t POOL_SIZE = 1024 * 1024;          // 1MB initial commit
+        constexpr size_t POOL_RESERVE = 64 * 1024 * 1024;  // 64MB growth limit
+        MemoryPool::Config pool_config;
+        pool_config.concurrency = replay_threads > 1 ? MemoryPool::Concurrency::CONCURRENT
+                                                     : MemoryPool::Concurrency::SINGLE_THREADED;
+        pool_config.reserve = POOL_RESERVE;
+        MemoryPool memory_pool(POOL_SIZE, pool_config);
         
         // Initialize device driver for I/O operations simulation
         DeviceDriver device_driver;
@@ -103,23 +139,31 @@ int main(int argc, char* argv[]) {
         // Set up logging system for system monitoring
         Logger& logger = Logger::get_instance();
         logger.set_min_level(Logger::Level::INFO);
-        logger.info("Kernel simulation starting");
+        LOG_INFO(logger, "Kernel simulation starting");
 
         // Start asynchronous device request processing
         device_driver.start_processing();
-        logger.info("Device driver initialized");
-
-        // Determine operation mode (test vs interactive)
-        bool test_mode = (argc > 1 && std::string(argv[1]) == "--test");
+        LOG_INFO(logger, "Device driver initialized");
 
         // Create command interface with appropriate mode
-        CLI cli(memory_pool, device_driver, test_mode);
+        CLI cli(memory_pool, device_driver, test_mode || replay_mode || script_mode || piped_mode);
 
         // Operation Phase
         // --------------
         if (test_mode) {
-            logger.info("Running in test mode");
+            LOG_INFO(logger, "Running in test mode");
             run_test_sequence(cli);
+        } else if (replay_mode) {
+            LOG_INFO(logger, "Running in replay mode");
+            cli.execute_command(replay_command);
+        } else if (script_mode) {
+            std::ifstream script(argv[2], std::ios::binary);
+            if (!script) throw std::runtime_error(std::string("Cannot open script ") + argv[2]);
+            LOG_INFO(logger, "Running script {}", argv[2]);
+            cli.run_script(script);
+        } else if (piped_mode) {
+            LOG_INFO(logger, "Running commands from standard input");
+            cli.run_script(std::cin);
         } else {
             cli.run(); // Interactive mode
         }
@@ -127,7 +171,7 @@ int main(int argc, char* argv[]) {
         // Cleanup Phase
         // ------------
         device_driver.stop_processing();
-        logger.info("Kernel simulation shutting down");
+        LOG_INFO(logger, "Kernel simulation shutting down");
 
     } catch (const std::exception& e) {
         // Error handling for system-level failures
@@ -0,0 +1,271 @@
+/*******************************************************************************
+ * Memory Arena Implementation
+ * --------------------------
+ * Region (bump) allocation on top of MemoryPool chunks, for scratch data
+ * that dies all at once, like one CLI command's tokens:
+ *
+ * Key OS Memory Management Concepts Demonstrated:
+ * 1. Region-Based Allocation
+ *    - Allocation bumps a cursor through the current chunk
+ *    - Individual frees are no-ops; reset() reclaims everything at once
+ *
+ * 2. Checkpoints
+ *    - checkpoint()/rewind() free everything allocated since a mark
+ *    - Scope does the same for a C++ block (like a stack frame)
+ *
+ * 3. Container Integration
+ *    - Derives from std::pmr::memory_resource, so std::pmr containers
+ *      can draw from it
+ *
+ * Implementation Notes:
+ * - Chunks come from MemoryPool::allocate and form an intrusive stack;
+ *   each chunk's header links to the chunk below it
+ * - Requests larger than a chunk get a chunk of their own
+ * - reset() keeps the first chunk, so a per-command arena settles into
+ *   zero pool traffic
+ * - Not synchronized; use one arena per thread (like SlabAllocator)
+ *
+ * Arena Layout:
+ * +--------------------------+   +--------------------------+
+ * | Chunk (oldest)           |<--| Chunk (current)          |
+ * | [hdr][obj][obj][obj]...  |   | [hdr][obj][obj] cursor-> |
+ * +--------------------------+   +--------------------------+
+ *
+ * Error Handling:
+ * - Pool exhausted: std::bad_alloc from MemoryPool
+ * - Alignment not a power of two: std::invalid_argument
+ * - Rewind to a checkpoint already released: undefined, as with any
+ *   stack discipline violation
+ ******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <stdexcept>
+#include <iostream>
+#include "memory_pool.hpp"
+
+/**
+ * MemoryArena Class
+ * ================
+ * Bump allocator whose chunks are MemoryPool blocks
+ */
+class MemoryArena : public std::pmr::memory_resource {
+    /**
+     * Chunk Header
+     * -----------
+     * Sits at the start of every chunk
+     */
+    struct Chunk {
+        Chunk* prev;     // Chunk allocated before this one
+        size_t size;     // Whole chunk size in bytes, header included
+    };
+
+    static constexpr size_t HEADER_SIZE =
+        (sizeof(Chunk) + alignof(std::max_align_t) - 1) & ~(alignof(std::max_align_t) - 1);
+
+public:
+    static constexpr size_t DEFAULT_CHUNK_SIZE = 4096;
+
+    /**
+     * Checkpoint
+     * ---------
+     * Arena position to rewind to; valid until a reset() or a rewind()
+     * to an earlier checkpoint
+     */
+    struct Checkpoint {
+        Chunk* chunk;    // Current chunk at the mark
+        char* cursor;    // Bump cursor at the mark
+        size_t used;     // bytes_used() at the mark
+    };
+
+private:
+    MemoryPool& pool;             // Chunk supplier
+    size_t chunk_size;            // Size of regular chunks
+    Chunk* current;               // Top of the chunk stack
+    char* cursor;                 // Next free byte in the current chunk
+    char* limit;                  // End of the current chunk
+    size_t chunks;                // Chunks held
+    size_t used;                  // Bytes handed out since the last reset (padding included)
+
+    static char* chunk_begin(Chunk* chunk) { return reinterpret_cast<char*>(chunk) + HEADER_SIZE; }
+    static char* chunk_end(Chunk* chunk) { return reinterpret_cast<char*>(chunk) + chunk->size; }
+
+    static char* align_up(char* ptr, size_t alignment) {
+        uintptr_t value = reinterpret_cast<uintptr_t>(ptr);
+        return reinterpret_cast<char*>((value + alignment - 1) & ~(uintptr_t(alignment) - 1));
+    }
+
+    /**
+     * Chunk Refill
+     * -----------
+     * Pushes a chunk large enough for `bytes` at `alignment`
+     */
+    void grow(size_t bytes, size_t alignment) {
+        size_t slack = alignment > alignof(std::max_align_t) ? alignment : 0;
+        if (bytes > SIZE_MAX - HEADER_SIZE - slack) throw std::bad_alloc();
+        size_t needed = HEADER_SIZE + slack + bytes;
+        size_t size = needed > chunk_size ? needed : chunk_size;
+
+        Chunk* chunk = static_cast<Chunk*>(pool.allocate(size));
+        chunk->prev = current;
+        chunk->size = size;
+        current = chunk;
+        cursor = chunk_begin(chunk);
+        limit = chunk_end(chunk);
+        ++chunks;
+    }
+
+    // Pops chunks until `keep` is on top (nullptr pops all)
+    void release_above(Chunk* keep) {
+        while (current && current != keep) {
+            Chunk* prev = current->prev;
+            pool.deallocate(current);
+            current = prev;
+            --chunks;
+        }
+    }
+
+protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        return allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void*, size_t, size_t) override {}  // Reclaimed by reset/rewind
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param backing: Pool that supplies chunks
+     * @param chunk: Size of regular chunks in bytes, header included
+     */
+    explicit MemoryArena(MemoryPool& backing, size_t chunk = DEFAULT_CHUNK_SIZE)
+        : pool(backing), chunk_size(chunk > 2 * HEADER_SIZE ? chunk : 2 * HEADER_SIZE),
+          current(nullptr), cursor(nullptr), limit(nullptr), chunks(0), used(0) {}
+
+    MemoryArena(const MemoryArena&) = delete;
+    MemoryArena& operator=(const MemoryArena&) = delete;
+
+    /**
+     * Destructor: Returns every chunk to the pool
+     */
+    ~MemoryArena() override {
+        release_above(nullptr);
+    }
+
+    /**
+     * Bump Allocation
+     * --------------
+     * @param bytes: Requested size (0 is served as 1)
+     * @param alignment: Power of two
+     * @return: Uninitialized memory valid until reset() or a rewind()
+     *          past this call
+     * @throws: std::bad_alloc if the pool cannot supply a chunk,
+     *          std::invalid_argument if alignment is not a power of two
+     */
+    void* allocate(size_t bytes, size_t alignment = alignof(std::max_align_t)) {
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            throw std::invalid_argument("Alignment must be a power of two");
+        }
+        if (bytes == 0) bytes = 1;
+
+        char* start = current ? align_up(cursor, alignment) : nullptr;
+        if (!current || start > limit || static_cast<size_t>(limit - start) < bytes) {
+            grow(bytes, alignment);
+            start = align_up(cursor, alignment);
+        }
+        used += static_cast<size_t>(start - cursor) + bytes;
+        cursor = start + bytes;
+        return start;
+    }
+
+    /**
+     * Bulk Reset
+     * ---------
+     * Frees everything at once; the oldest chunk is kept for reuse
+     */
+    void reset() {
+        if (!current) return;
+        Chunk* first = current;
+        while (first->prev) first = first->prev;
+        release_above(first);
+        cursor = chunk_begin(first);
+        limit = chunk_end(first);
+        used = 0;
+    }
+
+    /**
+     * Full Release
+     * -----------
+     * Returns every chunk to the pool, the first one included
+     */
+    void release() {
+        release_above(nullptr);
+        cursor = limit = nullptr;
+        used = 0;
+    }
+
+    /**
+     * Checkpoints
+     * ----------
+     * rewind() frees everything allocated since the matching checkpoint()
+     * and returns the chunks opened since then
+     */
+    Checkpoint checkpoint() const { return {current, cursor, used}; }
+
+    void rewind(const Checkpoint& mark) {
+        if (!mark.chunk) {
+            reset();
+            return;
+        }
+        release_above(mark.chunk);
+        used = mark.used;
+        cursor = mark.cursor;
+        limit = chunk_end(current);
+    }
+
+    /**
+     * Scoped Checkpoint
+     * ----------------
+     * Rewinds the arena when the scope ends:
+     *   { MemoryArena::Scope scratch(arena); ... }  // all freed here
+     */
+    class Scope {
+        MemoryArena& arena;
+        Checkpoint mark;
+
+    public:
+        explicit Scope(MemoryArena& owner) : arena(owner), mark(owner.checkpoint()) {}
+        ~Scope() { arena.rewind(mark); }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+    };
+
+    /**
+     * Accessors
+     * --------
+     */
+    MemoryPool& backing_pool() const { return pool; }
+    size_t bytes_used() const { return used; }
+    size_t chunk_count() const { return chunks; }
+
+    /**
+     * Statistics Display
+     * -----------------
+     * Prints chunk geometry and usage to the console.
+     */
+    void print_stats() const {
+        std::cout << "Memory Arena Stats:\n"
+                  << "Chunk Size: " << chunk_size << " bytes\n"
+                  << "Chunks: " << chunks << "\n"
+                  << "Bytes Used: " << used << "\n";
+    }
+};
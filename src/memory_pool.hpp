@@ -10,8 +10,10 @@
  *    - Address space management via pointers
  * 
  * 2. Memory Allocation Strategies
- *    - First-fit algorithm implementation
- *    - Block splitting for efficiency (like buddy system)
+ *    - First-fit algorithm implementation (default)
+ *    - Segregated-fit with power-of-two size-class bins
+ *    - Binary buddy system (see buddy_allocator.hpp)
+ *    - Block splitting for efficiency
  *    - Coalescing to combat fragmentation
  * 
  * 3. Resource Management
@@ -23,142 +25,1564 @@
  *    - Block merging (defragmentation)
  *    - Split avoidance for small allocations
  *    - Fragmentation monitoring
+ *    - Compaction of relocatable (handle-based) blocks
  * 
  * Implementation Notes:
- * - Block Structure: Models OS page table entries
- * - Allocation: O(n) search similar to linear page table scan
- * - Deallocation: O(1) direct access like page frame freeing
+ * - Block Structure: Boundary tags stored in-band, like OS page table entries
+ * - Allocation: O(log n) descent of the extent tree to the first chunk
+ *   holding a large enough block, then a short chunk walk (first-fit),
+ *   O(1) bin lookup via a bitmap of non-empty size classes (segregated-fit),
+ *   O(log n) split/merge over bitmap-tracked orders (buddy)
+ * - Deallocation: O(1) header lookup from the user pointer; both physical
+ *   neighbours are reached through their boundary tags and coalesced
+ * - Block Index: The tag chain is the address-ordered block index. Blocks
+ *   tile the pool back to back, so every scan moves forward through memory
+ *   and a block's neighbours are always its true physical neighbours
+ * - Extent Tree: The pool is cut into EXTENT_CHUNK-byte chunks; a max tree
+ *   over the chunks (see extent_tree.hpp) holds the largest free block
+ *   starting in each, kept current on every split, free and coalesce. The
+ *   root is the largest free block, so fragmentation queries are O(1)
+ *   (amortized: a chunk that lost its largest block is rescanned once,
+ *   on the next read of the tree)
+ * - Validation: validate() checks every invariant; define MEMORY_POOL_DEBUG
+ *   to run it after each allocate/deallocate
+ * - Concurrency: optional per-thread magazines of power-of-two blocks
+ *   (like per-CPU page lists); the central pool's mutex is only taken to
+ *   refill or flush a magazine in batches, or for large requests
+ * - Alignment: allocate(size, alignment) for SIMD/DMA buffers; boundary-tag
+ *   strategies carve a free leading block, buddy rounds the block up
+ * - Backing: heap, mmap, hugetlb or THP pages, optionally NUMA-bound
+ *   (see backing_store.hpp)
+ * - Tracing: allocate/deallocate events go to the binary log when one is
+ *   open (see binary_log.hpp); otherwise the cost is one relaxed load
+ * - Metrics: always-on striped counters of allocations and frees per block
+ *   size class, failures, and a sampled allocate latency histogram
+ *   (see metrics.hpp); export_metrics() renders them
+ * - Compaction: allocate_movable() returns a Handle instead of an address;
+ *   compact_step() slides unpinned movable blocks down over the free block
+ *   in front of them, one block per move, so free space gathers into one
+ *   extent. The pool is consistent after every move, which lets a pass
+ *   run in short time-bounded steps between ordinary allocations
+ * - Growth: Config::reserve reserves a virtual range up front; when no
+ *   block fits, the pool commits more of it (at least doubling) and the
+ *   new space joins the last block. trim() returns the interior pages of
+ *   free blocks idle for a number of trim() calls with MADV_DONTNEED,
+ *   unless the region is pinned by an I/O engine (pin_region())
+ * - Policies: BasicMemoryPool<Policy> takes strategy, concurrency, block
+ *   alignment, split threshold, magazine classes and stats collection
+ *   from a compile-time policy (see DefaultPoolPolicy). Fixed choices turn
+ *   mode checks into constants, so unused locking and counters compile
+ *   away; MemoryPool is the default policy, which defers to Config
  * 
  * Memory Layout:
  * +----------------+
  * | Memory Block   |
  * |  +----------+ |
- * |  | Metadata | |  <- Block tracking (size, status)
+ * |  | Header   | |  <- Boundary tag (size, status)
  * |  +----------+ |
- * |  | Data     | |  <- Actual memory space
+ * |  | Data     | |  <- Actual memory space (free-list links when free)
+ * |  +----------+ |
+ * |  | Footer   | |  <- Copy of the header, read by the next block
  * |  +----------+ |
  * +----------------+
  * 
  * Error Handling:
- * - Out of memory: std::bad_alloc
+ * - Out of memory (reservation included): std::bad_alloc
+ * - Reservation for a buddy pool: std::invalid_argument
+ * - Bad alignment (not a power of two): std::invalid_argument
+ * - Movable allocation from a buddy pool: std::invalid_argument
+ * - Stale or unknown handle: pin() returns nullptr, unpin/free ignore it
+ * - Boundary-tag pool beyond 2^32 ALIGNMENT units (64 GiB): std::invalid_argument
  * - Invalid free: Silent return
  * - Fragmentation: Monitored via ratio
+ * - Corruption: validate() throws std::logic_error
+ * - Inconsistent policy (alignment, cache classes): static_assert
  ******************************************************************************/
 
 #pragma once
+#include <algorithm>
+#include <array>
 #include <vector>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <optional>
 #include <stdexcept>
-#include <memory>
-#include <algorithm>
+#include <type_traits>
+#include <string>
 #include <iostream>
+#include "buddy_allocator.hpp"
+#include "extent_tree.hpp"
+#include "backing_store.hpp"
+#include "binary_log.hpp"
+#include "metrics.hpp"
+
+/**
+ * Debug Validation Hook
+ * --------------------
+ * Full-pool consistency check after every mutation; O(n), so opt-in
+ */
+#ifdef MEMORY_POOL_DEBUG
+#define MEMORY_POOL_CHECK() check_invariants()
+#else
+#define MEMORY_POOL_CHECK() ((void)0)
+#endif
+
+/**
+ * Pool Vocabulary
+ * ==============
+ * Types shared by every BasicMemoryPool instantiation, so a Config or a
+ * Handle means the same thing whatever the policy
+ */
+struct MemoryPoolTypes {
+    /**
+     * Allocation Strategy Selection
+     * ----------------------------
+     * - FIRST_FIT:      Linear scan for the first block that fits (default)
+     * - SEGREGATED_FIT: Free blocks binned by power-of-two size class;
+     *                   lookup jumps straight to a non-empty class that is
+     *                   guaranteed to fit, like a kernel's free-area lists
+     * - BUDDY:          Binary buddy system; power-of-two blocks that split
+     *                   and merge with their buddy (Linux page allocator)
+     */
+    enum class Strategy {
+        FIRST_FIT,       // Classic linear first-fit search
+        SEGREGATED_FIT,  // Size-class bins with bitmap lookup
+        BUDDY            // Binary buddy engine, no boundary tags
+    };
+
+    /**
+     * Concurrency Mode Selection
+     * -------------------------
+     * - SINGLE_THREADED: No synchronization (default)
+     * - CONCURRENT:      Safe to share between threads. Small requests are
+     *                    served from lock-free per-thread magazines that
+     *                    exchange blocks with the central pool in batches.
+     */
+    enum class Concurrency {
+        SINGLE_THREADED,  // Caller guarantees exclusive access
+        CONCURRENT        // Thread caches in front of a locked central pool
+    };
+
+    using Backing = BackingStore::Backing;
+
+    /**
+     * Pool Configuration
+     * -----------------
+     * Everything fixed at construction time:
+     * - strategy:    Allocation engine
+     * - concurrency: Single-threaded or thread-cached
+     * - backing:     Where the pool memory comes from
+     * - numa_node:   Bind the pool memory to this node (-1 = no binding)
+     * - reserve:     Virtual range the pool may grow into (0 = fixed size)
+     */
+    struct Config {
+        Strategy strategy = Strategy::FIRST_FIT;
+        Concurrency concurrency = Concurrency::SINGLE_THREADED;
+        Backing backing = Backing::HEAP;
+        int numa_node = -1;
+        size_t reserve = 0;
+    };
+
+    /**
+     * Relocatable Block Handle
+     * -----------------------
+     * Names a movable block across compactions; pin() turns it into an
+     * address that stays valid until the matching unpin()
+     */
+    struct Handle {
+        uint32_t slot = UINT32_MAX;   // Index in the handle table
+        uint32_t generation = 0;      // Must match the slot's, else stale
+
+        explicit operator bool() const { return slot != UINT32_MAX; }
+    };
+
+    /**
+     * Compaction Progress
+     * ------------------
+     * Result of one compact_step() or compact() call
+     */
+    struct CompactionProgress {
+        size_t blocks_moved = 0;   // Blocks relocated by this call
+        size_t bytes_moved = 0;    // Bytes copied by this call
+        bool complete = false;     // A full pass found nothing left to move
+    };
+
+    /**
+     * Strategy Name Lookup
+     * -------------------
+     * Human-readable strategy label for statistics output
+     */
+    static const char* strategy_name(Strategy strategy) {
+        switch (strategy) {
+            case Strategy::FIRST_FIT: return "first-fit";
+            case Strategy::SEGREGATED_FIT: return "segregated-fit";
+            case Strategy::BUDDY: return "buddy";
+            default: return "unknown";
+        }
+    }
+};
+
+/**
+ * Default Pool Policy
+ * ==================
+ * Compile-time configuration of BasicMemoryPool. A policy derives from
+ * this one and redeclares the members it wants to fix:
+ *
+ *   struct ScratchPolicy : DefaultPoolPolicy {
+ *       static constexpr std::optional<Strategy> strategy = Strategy::SEGREGATED_FIT;
+ *       static constexpr std::optional<Concurrency> concurrency = Concurrency::SINGLE_THREADED;
+ *       static constexpr bool collect_stats = false;
+ *   };
+ *
+ * A fixed strategy or concurrency overrides the Config field of the same
+ * name, and the branches for the other choices fold away at compile time.
+ */
+struct DefaultPoolPolicy {
+    using Strategy = MemoryPoolTypes::Strategy;
+    using Concurrency = MemoryPoolTypes::Concurrency;
+
+    static constexpr std::optional<Strategy> strategy = std::nullopt;        // nullopt: Config::strategy decides
+    static constexpr std::optional<Concurrency> concurrency = std::nullopt;  // nullopt: Config::concurrency decides
+    static constexpr size_t alignment = alignof(std::max_align_t);  // Block granularity and default data alignment
+    static constexpr size_t split_threshold = 0;    // Smallest remainder split off a block (MIN_BLOCK at least)
+    static constexpr size_t min_cache_class = 6;    // Smallest magazine block, log2 (64 bytes)
+    static constexpr size_t max_cache_class = 12;   // Largest magazine block, log2 (4096 bytes)
+    static constexpr size_t magazine_capacity = 64; // Blocks per thread magazine
+    static constexpr bool collect_stats = true;     // Allocation counters and latency histogram
+};
+
+/**
+ * BasicMemoryPool Class
+ * ====================
+ * The memory pool, specialized by a compile-time Policy; most code uses
+ * the MemoryPool alias below
+ */
+template <typename Policy = DefaultPoolPolicy>
+class BasicMemoryPool : public MemoryPoolTypes {
+public:
+    static constexpr size_t DEFAULT_ALIGNMENT = Policy::alignment;
 
-class MemoryPool {
 private:
-    struct MemoryBlock {
-        size_t size;         // Size of this memory block in bytes
-        bool is_allocated;   // Allocation status flag (true = in use)
-        char* data;         // Raw memory pointer to block's data region
+    static constexpr size_t ALIGNMENT = Policy::alignment;
+
+    static_assert(ALIGNMENT >= alignof(size_t) && (ALIGNMENT & (ALIGNMENT - 1)) == 0,
+                  "Policy alignment must be a power of two no smaller than a size_t");
+    static_assert(ALIGNMENT <= 4096, "Policy alignment beyond the page alignment of the backing store");
+
+    /**
+     * Boundary Tag
+     * -----------
+     * Written at both ends of every block. The header sits directly in
+     * front of the user data; the footer lets the following block find
+     * this one's start without any search. Padded to ALIGNMENT, so block
+     * data stays aligned.
+     */
+    struct alignas(ALIGNMENT) BlockTag {
+        size_t size;         // Whole block size in bytes, tags included
+        uint32_t flags;      // Block state bits (ALLOCATED, MOVABLE)
+        uint32_t reserved;   // MOVABLE: handle slot; free: idle stamp (trim epoch or RELEASED)
+    };
+
+    /**
+     * Free-List Links
+     * --------------
+     * Stored in the data region of free blocks only, so free-list
+     * bookkeeping costs no memory beyond the block itself.
+     */
+    struct FreeLinks {
+        BlockTag* prev;      // Previous free block in the same bin
+        BlockTag* next;      // Next free block in the same bin
+    };
+
+    static constexpr uint32_t ALLOCATED = 1u << 0;
+    static constexpr uint32_t MOVABLE = 1u << 1;   // Owned by a Handle; compaction may relocate it
+    static constexpr uint32_t RELEASED = UINT32_MAX;  // Idle stamp: interior pages returned to the OS
+    static constexpr size_t TAG_SIZE = sizeof(BlockTag);
+    static constexpr size_t OVERHEAD = 2 * TAG_SIZE;
+    static constexpr size_t MIN_BLOCK = (OVERHEAD + sizeof(FreeLinks) + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+    // A smaller remainder stays with the allocation instead of becoming a free block
+    static constexpr size_t SPLIT_THRESHOLD =
+        Policy::split_threshold > MIN_BLOCK ? (Policy::split_threshold + ALIGNMENT - 1) & ~(ALIGNMENT - 1) : MIN_BLOCK;
+
+    static_assert(TAG_SIZE % ALIGNMENT == 0, "Header must preserve data alignment");
+
+    // One bin per power of two: bin k holds free blocks of size [2^k, 2^(k+1))
+    static constexpr size_t NUM_BINS = sizeof(size_t) * 8;
+
+    // Address span of one extent-tree leaf; a chunk holds at most
+    // EXTENT_CHUNK / MIN_BLOCK block starts, which bounds each leaf refresh
+    static constexpr size_t EXTENT_CHUNK = 1024;
+
+    /**
+     * Thread Cache (Magazine) Layout
+     * -----------------------------
+     * Cached classes are whole-block sizes 2^MIN_CACHE_CLASS..2^MAX_CACHE_CLASS.
+     * A magazine refills with CACHE_BATCH blocks when empty and flushes the
+     * same number back when full, so the central lock is amortized.
+     */
+    static constexpr size_t MIN_CACHE_CLASS = Policy::min_cache_class;
+    static constexpr size_t MAX_CACHE_CLASS = Policy::max_cache_class;
+    static constexpr size_t CACHE_CLASSES = MAX_CACHE_CLASS - MIN_CACHE_CLASS + 1;
+    static constexpr size_t MAGAZINE_CAPACITY = Policy::magazine_capacity;
+    static constexpr size_t CACHE_BATCH = MAGAZINE_CAPACITY / 2;
+
+    static_assert((size_t(1) << MIN_CACHE_CLASS) >= MIN_BLOCK, "Cached blocks must hold free links");
+    static_assert(MIN_CACHE_CLASS <= MAX_CACHE_CLASS && MAX_CACHE_CLASS < 32, "Bad policy cache classes");
+    static_assert(MAGAZINE_CAPACITY >= 2, "Magazines must hold a refill batch");
+
+    // One allocate call in this many per thread is timed for the latency histogram
+    static constexpr uint32_t LATENCY_SAMPLE_INTERVAL = 16;
+
+    struct ThreadCache {
+        BasicMemoryPool* pool;    // Owning pool; nullptr once the pool is destroyed
+        std::array<std::array<void*, MAGAZINE_CAPACITY>, CACHE_CLASSES> magazines;
+        std::array<size_t, CACHE_CLASSES> counts;
+
+        explicit ThreadCache(BasicMemoryPool* owner) : pool(owner) { counts.fill(0); }
+    };
+
+    /**
+     * Per-Thread Cache Table
+     * ---------------------
+     * One entry per pool this thread has used, keyed by the pool's unique
+     * id so a new pool at a recycled address never sees stale magazines.
+     * On thread exit, remaining blocks are handed back to live pools.
+     */
+    struct ThreadCacheTable {
+        struct Entry {
+            uint64_t pool_id;
+            std::unique_ptr<ThreadCache> cache;
+        };
+        std::vector<Entry> entries;
 
-        // Constructor initializes a new memory block
-        MemoryBlock(size_t s, char* d) : size(s), is_allocated(false), data(d) {}
+        ~ThreadCacheTable() {
+            std::lock_guard<std::mutex> lock(cache_registry_mutex());
+            for (auto& entry : entries) {
+                if (entry.cache->pool) entry.cache->pool->retire_cache(entry.cache.get());
+            }
+        }
     };
 
-    std::vector<MemoryBlock> blocks;  // Dynamic array of memory block metadata
+    BackingStore memory;              // OS memory behind the pool
     char* pool;                       // Contiguous memory buffer pointer
-    size_t total_size;                // Total pool size in bytes
-    size_t used_size;                 // Currently allocated bytes
+    size_t total_size;                // Total pool size in bytes (committed part of a reservation)
+    size_t reserve_limit;             // Size the pool may grow to; total_size if fixed
+    std::atomic<size_t> committed_size;  // Copy of total_size for lock-free ownership checks
+    size_t used_size;                 // Currently allocated bytes (tags included)
+    size_t block_count;               // Number of blocks, free and allocated
+    size_t free_blocks;               // Number of free blocks (boundary-tag strategies)
+    Strategy strategy;                // Allocation strategy chosen at construction
+    std::unique_ptr<BuddyAllocator> buddy;  // Engine for Strategy::BUDDY
+    Concurrency concurrency;          // Locking/caching mode chosen at construction
+    uint64_t pool_id;                 // Unique id for thread-cache lookup
+    mutable std::mutex central_mutex; // Guards blocks and bins in CONCURRENT mode
+    std::vector<ThreadCache*> caches; // Live thread caches (cache registry lock)
+
+    std::array<BlockTag*, NUM_BINS> bins;  // Heads of the per-class free lists
+    uint64_t bin_map;                 // Bit k set when bins[k] is non-empty
+    std::array<size_t, NUM_BINS> bin_counts;  // Free blocks per size class
+
+    mutable ExtentTree extents;       // Largest free block per chunk, in ALIGNMENT units
+    std::vector<uint32_t> chunk_first;  // First block start per chunk, in ALIGNMENT units (NO_BLOCK if none)
+    mutable std::vector<uint8_t> chunk_stale;    // Set while a chunk's leaf may overstate it
+    mutable std::vector<uint32_t> stale_chunks;  // Chunks with chunk_stale set
+    static constexpr uint32_t NO_BLOCK = UINT32_MAX;
+
+    /**
+     * Pool Counters
+     * ------------
+     * Present only when the policy collects stats; otherwise an empty
+     * struct, and every update is compiled out
+     */
+    struct PoolCounters {
+        StripedCounters<NUM_BINS> allocations;  // Blocks handed out, by block size class
+        StripedCounters<NUM_BINS> frees;        // Blocks returned, by block size class
+        StripedCounter allocation_failures;     // Requests answered with bad_alloc
+        Histogram allocate_latency;             // Sampled allocate() time in ns
+    };
+    struct NoCounters {};
+
+    std::conditional_t<Policy::collect_stats, PoolCounters, NoCounters> counters;
+
+    /**
+     * Handle Table Slot
+     * ----------------
+     * One per live movable block; freed slots are reused with a new
+     * generation so handles to the old block no longer resolve
+     */
+    struct HandleSlot {
+        void* data;              // Current user address; nullptr while the slot is free
+        uint32_t pins;           // Outstanding pin() calls; pinned blocks never move
+        uint32_t generation;     // Bumped on free
+    };
+
+    std::vector<HandleSlot> handle_table;   // Indexed by Handle::slot
+    std::vector<uint32_t> free_handle_slots;  // Reusable table indices
+    size_t compact_cursor;                  // Pool offset where the current pass resumes
+    bool compact_pass_clean;                // No move or pool change since the current pass began
+    size_t compacted_blocks;                // Blocks moved by compaction, all time
+    size_t compacted_bytes;                 // Bytes moved by compaction, all time
+    size_t grow_count;                      // Times the pool committed more of its reservation
+    uint32_t trim_epoch;                    // trim() calls so far; stamps newly free blocks
+    size_t released_bytes;                  // Bytes returned to the OS by trim(), all time
+    size_t region_pins;                     // Outstanding pin_region() calls; trim() is off while nonzero
+
+    /**
+     * Mode Queries
+     * -----------
+     * Constants when the policy fixes the choice, so the branches they
+     * guard fold away; otherwise read from the Config-derived members
+     */
+    Strategy active_strategy() const {
+        if constexpr (Policy::strategy.has_value()) return *Policy::strategy;
+        else return strategy;
+    }
+
+    bool is_segregated() const { return active_strategy() == Strategy::SEGREGATED_FIT; }
+    bool is_buddy() const { return active_strategy() == Strategy::BUDDY; }
+
+    bool is_concurrent() const {
+        if constexpr (Policy::concurrency.has_value()) return *Policy::concurrency == Concurrency::CONCURRENT;
+        else return concurrency == Concurrency::CONCURRENT;
+    }
+
+    /**
+     * Central Lock
+     * -----------
+     * Held for the whole of a public call in CONCURRENT mode; an empty
+     * object when the policy fixes SINGLE_THREADED
+     */
+    struct NoLock {
+        ~NoLock() {}  // User-provided, so an unused lock variable draws no warning
+    };
+
+    auto central_lock() const {
+        if constexpr (Policy::concurrency == Concurrency::SINGLE_THREADED) {
+            return NoLock();
+        } else {
+            std::unique_lock<std::mutex> lock(central_mutex, std::defer_lock);
+            if (is_concurrent()) lock.lock();
+            return lock;
+        }
+    }
+
+    /**
+     * Boundary Tag Navigation
+     * ----------------------
+     * All O(1): header from user pointer, footer from header, and the
+     * physical neighbours on either side.
+     */
+    static BlockTag* header_of(void* ptr) {
+        return reinterpret_cast<BlockTag*>(static_cast<char*>(ptr) - TAG_SIZE);
+    }
+
+    static char* data_of(BlockTag* block) {
+        return reinterpret_cast<char*>(block) + TAG_SIZE;
+    }
+
+    static BlockTag* footer_of(BlockTag* block) {
+        return reinterpret_cast<BlockTag*>(
+            reinterpret_cast<char*>(block) + block->size - TAG_SIZE);
+    }
+
+    static FreeLinks* links_of(BlockTag* block) {
+        return reinterpret_cast<FreeLinks*>(data_of(block));
+    }
+
+    BlockTag* next_block(BlockTag* block) const {
+        char* next = reinterpret_cast<char*>(block) + block->size;
+        return next < pool + total_size ? reinterpret_cast<BlockTag*>(next) : nullptr;
+    }
+
+    BlockTag* prev_block(BlockTag* block) const {
+        if (reinterpret_cast<char*>(block) == pool) return nullptr;
+        BlockTag* prev_footer = reinterpret_cast<BlockTag*>(
+            reinterpret_cast<char*>(block) - TAG_SIZE);
+        return reinterpret_cast<BlockTag*>(
+            reinterpret_cast<char*>(block) - prev_footer->size);
+    }
+
+    static void write_tags(BlockTag* block, size_t size, uint32_t flags, uint32_t reserved = 0) {
+        block->size = size;
+        block->flags = flags;
+        block->reserved = reserved;
+        *footer_of(block) = *block;
+    }
+
+    static bool is_free(const BlockTag* block) {
+        return block && !(block->flags & ALLOCATED);
+    }
+
+    /**
+     * Request Size Rounding
+     * --------------------
+     * Converts a user request into a whole block size: aligned payload
+     * plus header and footer, never smaller than a free block needs.
+     */
+    static size_t block_size_for(size_t size) {
+        if (size > SIZE_MAX - OVERHEAD - ALIGNMENT) throw std::bad_alloc();
+        size_t payload = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        size_t needed = payload + OVERHEAD;
+        return needed < MIN_BLOCK ? MIN_BLOCK : needed;
+    }
+
+    /**
+     * Size Class Computation
+     * ---------------------
+     * Returns floor(log2(size)), the bin index for a block of this size
+     */
+    static size_t size_class(size_t size) {
+        return size ? sizeof(unsigned long long) * 8 - 1 - static_cast<size_t>(__builtin_clzll(size)) : 0;
+    }
+
+    /**
+     * Bin Maintenance
+     * --------------
+     * O(1) push/unlink on the intrusive doubly linked free list of the
+     * block's size class. Only used by the segregated-fit strategy.
+     */
+    void bin_insert(BlockTag* block) {
+        size_t bin = size_class(block->size);
+        FreeLinks* links = links_of(block);
+        links->prev = nullptr;
+        links->next = bins[bin];
+        if (bins[bin]) links_of(bins[bin])->prev = block;
+        bins[bin] = block;
+        ++bin_counts[bin];
+        bin_map |= (uint64_t(1) << bin);
+    }
+
+    void bin_remove(BlockTag* block) {
+        size_t bin = size_class(block->size);
+        FreeLinks* links = links_of(block);
+        if (links->prev) links_of(links->prev)->next = links->next;
+        else bins[bin] = links->next;
+        if (links->next) links_of(links->next)->prev = links->prev;
+        --bin_counts[bin];
+        if (!bins[bin]) bin_map &= ~(uint64_t(1) << bin);
+    }
+
+    /**
+     * Segregated-Fit Lookup
+     * --------------------
+     * Every block in a bin above size_class(size) fits, so the lowest such
+     * non-empty bin is found with one bitmap scan. Only when no larger class
+     * exists is the request's own class searched entry by entry.
+     */
+    BlockTag* find_segregated(size_t size) const {
+        size_t bin = size_class(size);
+        uint64_t larger = (bin + 1 < NUM_BINS) ? (bin_map & (~uint64_t(0) << (bin + 1))) : 0;
+        if (larger) {
+            size_t target = 0;
+            while (!(larger & (uint64_t(1) << target))) ++target;
+            return bins[target];
+        }
+        for (BlockTag* block = bins[bin]; block; block = links_of(block)->next) {
+            if (block->size >= size) return block;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Extent Tree Maintenance
+     * ----------------------
+     * Every change is O(1) plus a climb that stops at the first ancestor
+     * already large enough:
+     * - extent_raise(): a free block now starts in the chunk
+     * - note_boundary()/drop_boundary(): a block start appeared/vanished
+     * - mark_stale(): the chunk lost its largest free block
+     * A stale leaf only overstates its chunk. settle_extents() rescans the
+     * stale chunks (at most EXTENT_CHUNK / MIN_BLOCK blocks each) before
+     * the tree is read, so each rescan is paid for once by the operation
+     * that caused it, and by segregated-fit only when stats are read.
+     * All are called once the tags are final.
+     */
+    size_t chunk_of(const void* address) const {
+        return static_cast<size_t>(static_cast<const char*>(address) - pool) / EXTENT_CHUNK;
+    }
+
+    // Pool offsets and block sizes are ALIGNMENT multiples; the tree stores units
+    static uint32_t units(size_t bytes) {
+        return static_cast<uint32_t>(bytes / ALIGNMENT);
+    }
+
+    uint32_t offset_of(const void* address) const {
+        return units(static_cast<size_t>(static_cast<const char*>(address) - pool));
+    }
+
+    void extent_raise(const BlockTag* block) {
+        extents.raise(chunk_of(block), units(block->size));
+    }
+
+    void note_boundary(const BlockTag* block) {
+        size_t chunk = chunk_of(block);
+        uint32_t offset = offset_of(block);
+        if (chunk_first[chunk] == NO_BLOCK || offset < chunk_first[chunk]) chunk_first[chunk] = offset;
+    }
+
+    // `successor` is the first block that survives after the vanished start
+    void drop_boundary(const void* start, const BlockTag* successor) {
+        size_t chunk = chunk_of(start);
+        if (chunk_first[chunk] != offset_of(start)) return;
+        chunk_first[chunk] = successor && chunk_of(successor) == chunk ? offset_of(successor) : NO_BLOCK;
+    }
+
+    void mark_stale(size_t chunk) {
+        if (chunk_stale[chunk]) return;
+        chunk_stale[chunk] = 1;
+        stale_chunks.push_back(static_cast<uint32_t>(chunk));
+    }
+
+    void settle_extents() const {
+        for (uint32_t chunk : stale_chunks) {
+            uint32_t largest = 0;
+            if (chunk_first[chunk] != NO_BLOCK) {
+                char* high = pool + (size_t(chunk) + 1) * EXTENT_CHUNK;
+                for (BlockTag* block = chunk_head(chunk); block && reinterpret_cast<char*>(block) < high;
+                     block = next_block(block)) {
+                    if (is_free(block)) largest = std::max(largest, units(block->size));
+                }
+            }
+            if (extents.get(chunk) != largest) extents.set(chunk, largest);
+            chunk_stale[chunk] = 0;
+        }
+        stale_chunks.clear();
+    }
+
+    BlockTag* chunk_head(size_t chunk) const {
+        return reinterpret_cast<BlockTag*>(pool + size_t(chunk_first[chunk]) * ALIGNMENT);
+    }
+
+    /**
+     * First-Fit Lookup
+     * ---------------
+     * Jumps to the first chunk that holds a fitting block and walks the
+     * blocks that start there; same result as a scan from the pool start
+     */
+    BlockTag* find_first_fit(size_t size) const {
+        settle_extents();
+        size_t chunk = extents.find(0, units(size));
+        if (chunk == extents.size()) return nullptr;
+        char* high = pool + (chunk + 1) * EXTENT_CHUNK;
+        for (BlockTag* block = chunk_head(chunk); reinterpret_cast<char*>(block) < high;
+             block = next_block(block)) {
+            if (is_free(block) && block->size >= size) return block;
+        }
+        throw std::logic_error("MemoryPool extent tree out of date");
+    }
+
+    /**
+     * Alignment Padding
+     * ----------------
+     * Bytes to skip at the front of a free block so its data lands on
+     * `alignment`. A non-zero gap must hold a free block of its own.
+     */
+    static size_t leading_gap(const BlockTag* block, size_t alignment) {
+        uintptr_t data = reinterpret_cast<uintptr_t>(block) + TAG_SIZE;
+        uintptr_t mask = alignment - 1;
+        size_t gap = ((data + mask) & ~mask) - data;
+        if (gap != 0 && gap < MIN_BLOCK) gap = ((data + MIN_BLOCK + mask) & ~mask) - data;
+        return gap;
+    }
+
+    // Chunks without a block of `size` bytes cannot fit size + gap either
+    BlockTag* find_first_fit_aligned(size_t size, size_t alignment, size_t& gap) const {
+        settle_extents();
+        for (size_t chunk = extents.find(0, units(size)); chunk < extents.size();
+             chunk = extents.find(chunk + 1, units(size))) {
+            char* high = pool + (chunk + 1) * EXTENT_CHUNK;
+            for (BlockTag* block = chunk_head(chunk); block && reinterpret_cast<char*>(block) < high;
+                 block = next_block(block)) {
+                if (!is_free(block)) continue;
+                gap = leading_gap(block, alignment);
+                if (block->size >= gap + size) return block;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Pointer Ownership Check
+     * ----------------------
+     * Cheap O(1) sanity test before trusting an in-band header
+     */
+    bool tag_owns(void* ptr) const {
+        char* p = static_cast<char*>(ptr);
+        char* end = pool + committed_size.load(std::memory_order_relaxed);  // May run unlocked
+        if (p < pool + TAG_SIZE || p >= end) return false;
+        if (static_cast<size_t>(p - pool) % ALIGNMENT != 0) return false;
+        BlockTag* block = header_of(ptr);
+        if ((block->flags & (ALLOCATED | MOVABLE)) != ALLOCATED) return false;  // Movable: freed by handle
+        size_t room = static_cast<size_t>(end - reinterpret_cast<char*>(block));
+        if (block->size < MIN_BLOCK || block->size > room) return false;
+        return footer_of(block)->size == block->size;
+    }
+
+    /**
+     * Boundary-Tag Allocation
+     * ----------------------
+     * Finds, splits and marks a block of exactly `needed` bytes or more.
+     * Over-aligned requests first split off a free leading block so the
+     * data address is aligned; a segregated search asks for enough slack
+     * that any block in the chosen class is guaranteed to fit.
+     * Returns nullptr instead of throwing so callers can retry after
+     * returning cached blocks.
+     */
+    BlockTag* tag_allocate(size_t needed, size_t alignment) {
+        bool segregated = is_segregated();
+        BlockTag* block = nullptr;
+        size_t gap = 0;
+        if (alignment <= ALIGNMENT) {
+            block = segregated ? find_segregated(needed) : find_first_fit(needed);
+        } else if (segregated) {
+            block = find_segregated(needed + alignment + MIN_BLOCK);
+            if (block) gap = leading_gap(block, alignment);
+        } else {
+            block = find_first_fit_aligned(needed, alignment, gap);
+        }
+        if (!block) return nullptr;
+
+        if (segregated) bin_remove(block);
+        BlockTag* start = block;
+        uint32_t stamp = block->reserved;  // Pieces left free keep their idle age
+        bool was_largest = extents.get(chunk_of(start)) == units(start->size);
+        --free_blocks;
+
+        // Carve the alignment gap into a free block; its left neighbour
+        // is allocated, so no coalescing is needed
+        if (gap) {
+            size_t rest = block->size - gap;
+            write_tags(block, gap, 0, stamp);
+            if (segregated) bin_insert(block);
+            ++block_count;
+            ++free_blocks;
+            block = reinterpret_cast<BlockTag*>(reinterpret_cast<char*>(block) + gap);
+            write_tags(block, rest, 0);
+        }
+
+        // Split block if the remainder can hold a free block of its own
+        size_t block_size = block->size;
+        BlockTag* remainder = nullptr;
+        if (block_size - needed >= SPLIT_THRESHOLD) {
+            remainder = reinterpret_cast<BlockTag*>(reinterpret_cast<char*>(block) + needed);
+            write_tags(remainder, block_size - needed, 0, stamp);
+            if (segregated) bin_insert(remainder);
+            ++block_count;
+            ++free_blocks;
+            block_size = needed;
+        }
+
+        // Mark block as allocated and update usage stats
+        write_tags(block, block_size, ALLOCATED);
+        used_size += block_size;
+
+        // New starts at most at the data block and the remainder
+        if (gap) {
+            note_boundary(block);
+            extent_raise(start);
+        }
+        if (remainder) {
+            note_boundary(remainder);
+            extent_raise(remainder);
+        }
+        if (was_largest) mark_stale(chunk_of(start));
+        return block;
+    }
+
+    /**
+     * Boundary-Tag Deallocation
+     * ------------------------
+     * Frees a block and merges it with free physical neighbours on both
+     * sides.
+     */
+    void tag_release(BlockTag* block) {
+        bool segregated = is_segregated();
+        size_t size = block->size;
+        used_size -= size;
+        ++free_blocks;
+        void* freed = block;
+
+        // Merge with following block if it's free
+        void* merged_next = nullptr;     // Start of the absorbed next block
+        size_t merged_size = 0;
+        BlockTag* next = next_block(block);
+        if (is_free(next)) {
+            if (segregated) bin_remove(next);
+            merged_next = next;
+            merged_size = next->size;
+            size += next->size;
+            --block_count;
+            --free_blocks;
+        }
+
+        // Merge into preceding block if it's free
+        BlockTag* prev = prev_block(block);
+        if (is_free(prev)) {
+            if (segregated) bin_remove(prev);
+            size += prev->size;
+            block = prev;
+            --block_count;
+            --free_blocks;
+        }
+
+        write_tags(block, size, 0, trim_epoch);
+        if (segregated) bin_insert(block);
+
+        // The merged block outgrows whatever it absorbed in its own chunk;
+        // an absorbed next block in a later chunk may have been its largest
+        BlockTag* successor = next_block(block);
+        if (block != freed) drop_boundary(freed, successor);
+        extent_raise(block);
+        if (merged_next) {
+            size_t chunk = chunk_of(merged_next);
+            bool was_largest = extents.get(chunk) == units(merged_size);
+            drop_boundary(merged_next, successor);
+            if (was_largest && chunk != chunk_of(block)) mark_stale(chunk);
+        }
+    }
+
+    /**
+     * Pool Growth
+     * ----------
+     * Commits more of the reservation so that a block of `needed` bytes
+     * fits at the pool end. The pool at least doubles (up to the limit),
+     * so the O(chunks) extent-tree rebuild is amortized over the space
+     * gained. The new space extends a free last block or becomes one.
+     * @return: False if the reservation cannot provide it
+     */
+    bool grow(size_t needed) {
+        if (is_buddy() || total_size >= reserve_limit) return false;
+        bool segregated = is_segregated();
+        BlockTag* last_footer = reinterpret_cast<BlockTag*>(pool + total_size - TAG_SIZE);
+        BlockTag* last = reinterpret_cast<BlockTag*>(pool + total_size - last_footer->size);
+        size_t tail = is_free(last) ? last->size : 0;
+        size_t shortfall = needed > tail ? needed - tail : 0;
+        if (shortfall > reserve_limit - total_size) return false;
+
+        size_t target = std::min(std::max(total_size + shortfall, 2 * total_size), reserve_limit);
+        if (!memory.commit(target)) return false;
+        size_t grown = std::min(memory.size(), reserve_limit);
+        size_t added = grown - total_size;
+        char* old_end = pool + total_size;
+        total_size = grown;
+        committed_size.store(total_size, std::memory_order_relaxed);
+        ++grow_count;
+
+        size_t chunks = (total_size + EXTENT_CHUNK - 1) / EXTENT_CHUNK;
+        extents.resize(chunks);
+        chunk_first.resize(chunks, NO_BLOCK);
+        chunk_stale.resize(chunks, 0);
+
+        if (tail) {
+            if (segregated) bin_remove(last);
+            write_tags(last, tail + added, 0, trim_epoch);
+            if (segregated) bin_insert(last);
+            extent_raise(last);
+        } else {
+            BlockTag* block = reinterpret_cast<BlockTag*>(old_end);
+            write_tags(block, added, 0, trim_epoch);
+            if (segregated) bin_insert(block);
+            ++block_count;
+            ++free_blocks;
+            note_boundary(block);
+            extent_raise(block);
+        }
+        return true;
+    }
+
+    /**
+     * Handle Resolution
+     * ----------------
+     * @return: The live slot `handle` names, or nullptr if it is stale
+     */
+    HandleSlot* resolve(Handle handle) {
+        if (handle.slot >= handle_table.size()) return nullptr;
+        HandleSlot& slot = handle_table[handle.slot];
+        return slot.data && slot.generation == handle.generation ? &slot : nullptr;
+    }
+
+    /**
+     * Compaction Hole Search
+     * ---------------------
+     * First free block starting at or after pool offset `from`. The extent
+     * tree skips chunks without free starts; stale leaves only cost a walk.
+     */
+    BlockTag* next_hole(size_t from) const {
+        if (from >= total_size) return nullptr;
+        char* low = pool + from;
+        for (size_t chunk = extents.find(from / EXTENT_CHUNK, 1); chunk < extents.size();
+             chunk = extents.find(chunk + 1, 1)) {
+            if (chunk_first[chunk] == NO_BLOCK) continue;  // Stale: its blocks were absorbed
+            char* high = pool + (chunk + 1) * EXTENT_CHUNK;
+            for (BlockTag* block = chunk_head(chunk); block && reinterpret_cast<char*>(block) < high;
+                 block = next_block(block)) {
+                if (is_free(block) && reinterpret_cast<char*>(block) >= low) return block;
+            }
+        }
+        return nullptr;
+    }
+
+    /**
+     * Block Slide
+     * ----------
+     * Moves `block` down over the free `hole` directly in front of it:
+     *
+     *   [hole][block][free?]  ->  [block][hole + free?]
+     *
+     * The hole reappears behind the block, merged with a following free
+     * block, and the block's handle is pointed at its new address.
+     * @return: The relocated hole
+     */
+    BlockTag* slide_down(BlockTag* hole, BlockTag* block) {
+        bool segregated = is_segregated();
+        char* start = reinterpret_cast<char*>(hole);
+        char* old_block = reinterpret_cast<char*>(block);
+        size_t hole_size = hole->size, block_size = block->size;
+        uint32_t owner = block->reserved;
+
+        BlockTag* after = next_block(block);
+        bool merge = is_free(after);
+        size_t after_size = merge ? after->size : 0;
+        char* old_after = reinterpret_cast<char*>(after);
+
+        // Free blocks that vanish may have been their chunk's largest
+        bool hole_largest = extents.get(chunk_of(start)) == units(hole_size);
+        bool after_largest = merge && extents.get(chunk_of(old_after)) == units(after_size);
+
+        if (segregated) {
+            bin_remove(hole);
+            if (merge) bin_remove(after);
+        }
+        std::memmove(start, old_block, block_size);  // Tags travel with the block
+        BlockTag* moved = reinterpret_cast<BlockTag*>(start);
+        BlockTag* gap = reinterpret_cast<BlockTag*>(start + block_size);
+        write_tags(gap, hole_size + after_size, 0, trim_epoch);
+        if (segregated) bin_insert(gap);
+        if (merge) {
+            --block_count;
+            --free_blocks;
+        }
+        handle_table[owner].data = data_of(moved);
+
+        // Starts inside [start, end) are now just `moved` and `gap`
+        char* end = reinterpret_cast<char*>(gap) + gap->size;
+        auto rehead = [&](const void* address) {
+            size_t chunk = chunk_of(address);
+            if (chunk == chunk_of(start)) return;  // Still headed by `start` or earlier
+            uint32_t first = NO_BLOCK;
+            if (chunk_of(gap) == chunk) first = offset_of(gap);
+            else if (end < pool + total_size && chunk_of(end) == chunk) first = offset_of(end);
+            chunk_first[chunk] = first;
+        };
+        rehead(old_block);
+        if (merge) rehead(old_after);
+        rehead(gap);
+
+        extent_raise(gap);
+        if (hole_largest) mark_stale(chunk_of(start));
+        if (after_largest) mark_stale(chunk_of(old_after));
+        return gap;
+    }
+
+    /**
+     * Engine Dispatch
+     * --------------
+     * Engine-neutral block operations on user data pointers. Block sizes
+     * are whole engine blocks: tags included for boundary-tag strategies,
+     * a power of two for buddy. Caller holds central_mutex when CONCURRENT.
+     */
+    size_t block_size_for_request(size_t size, size_t alignment = ALIGNMENT) const {
+        if (is_buddy()) {
+            // Buddy blocks are aligned to their own size relative to the base
+            size_t block = size_t(1) << BuddyAllocator::order_for(size);
+            return block < alignment ? alignment : block;
+        }
+        return block_size_for(size);
+    }
+
+    void* allocate_block(size_t block_size, size_t alignment = ALIGNMENT) {
+        compact_pass_clean = false;
+        void* data = nullptr;
+        if (is_buddy()) {
+            if (alignment <= memory.base_alignment()) data = buddy->allocate(block_size);
+        } else if (BlockTag* block = tag_allocate(block_size, alignment)) {
+            data = data_of(block);
+        } else if (grow(block_size + (alignment > ALIGNMENT ? alignment + MIN_BLOCK : 0))) {
+            // Enough for any alignment gap, so the retry cannot fail
+            if (BlockTag* grown = tag_allocate(block_size, alignment)) data = data_of(grown);
+        }
+        MEMORY_POOL_CHECK();
+        return data;
+    }
+
+    void release_block(void* data) {
+        compact_pass_clean = false;
+        if (is_buddy()) buddy->deallocate(data);
+        else tag_release(header_of(data));
+        MEMORY_POOL_CHECK();
+    }
+
+    size_t block_size_of(void* data) const {
+        return is_buddy() ? buddy->block_size(data) : header_of(data)->size;
+    }
+
+    bool owns(void* ptr) const {
+        return is_buddy() ? buddy->owns(ptr) : tag_owns(ptr);
+    }
+
+    size_t used_bytes() const { return is_buddy() ? buddy->used() : used_size; }
+    size_t total_blocks() const { return is_buddy() ? buddy->block_count() : block_count; }
+    size_t free_block_total() const { return is_buddy() ? buddy->free_block_count() : free_blocks; }
+    size_t largest_free() const {
+        if (is_buddy()) return buddy->largest_free_block();
+        settle_extents();
+        return size_t(extents.max()) * ALIGNMENT;
+    }
+
+    /**
+     * Allocation Trace Point
+     * ---------------------
+     * Every successful allocation passes through here, so it is also where
+     * allocations are counted; failures go through allocation_failed()
+     */
+    void* traced(void* data, size_t size) {
+        BLOG(Logger::Level::DEBUG, "MemoryPool allocate {} bytes at {}", size, data);
+        if constexpr (Policy::collect_stats) counters.allocations.add(size_class(block_size_of(data)));
+        return data;
+    }
+
+    [[noreturn]] void allocation_failed() {
+        if constexpr (Policy::collect_stats) counters.allocation_failures.add(0);
+        throw std::bad_alloc();
+    }
+
+    void* allocate_untimed(size_t size, size_t alignment) {
+        if (size == 0) return nullptr;  // Handle zero-size request
+        if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+            throw std::invalid_argument("Alignment must be a power of two");
+        }
+        if (alignment < ALIGNMENT) alignment = ALIGNMENT;
+
+        size_t needed = block_size_for_request(size, alignment);
+        if (!is_concurrent()) {
+            void* data = allocate_block(needed, alignment);
+            if (!data) allocation_failed();  // No suitable block found
+            return traced(data, size);
+        }
+
+        // Fast path: pop from this thread's magazine without locking
+        size_t cls = alignment == ALIGNMENT ? cache_class_for_block(needed) : CACHE_CLASSES;
+        if (cls < CACHE_CLASSES) {
+            ThreadCache& cache = local_cache();
+            if (cache.counts[cls] > 0) {
+                return traced(cache.magazines[cls][--cache.counts[cls]], size);
+            }
+            void* data = refill_magazine(cache, cls);
+            if (!data) allocation_failed();
+            return traced(data, size);
+        }
+
+        // Large or over-aligned request: straight to the central pool
+        std::lock_guard<std::mutex> lock(central_mutex);
+        void* data = allocate_block(needed, alignment);
+        if (!data) allocation_failed();
+        return traced(data, size);
+    }
+
+    /**
+     * Cache Class Mapping
+     * ------------------
+     * Cached requests are rounded up to a power-of-two block so any block
+     * in a magazine satisfies any request of that class.
+     * @return: Magazine index, or CACHE_CLASSES when not cacheable
+     */
+    static size_t cache_class_for_block(size_t block_size) {
+        size_t cls = MIN_CACHE_CLASS;
+        while (cls <= MAX_CACHE_CLASS && (size_t(1) << cls) < block_size) ++cls;
+        return cls <= MAX_CACHE_CLASS ? cls - MIN_CACHE_CLASS : CACHE_CLASSES;
+    }
+
+    size_t cache_class_of(void* data) const {
+        size_t block_size = block_size_of(data);
+        size_t cls = cache_class_for_block(block_size);
+        if (cls == CACHE_CLASSES || block_size != (size_t(1) << (cls + MIN_CACHE_CLASS))) {
+            return CACHE_CLASSES;
+        }
+        return cls;
+    }
+
+    static std::mutex& cache_registry_mutex() {
+        static std::mutex registry_mutex;
+        return registry_mutex;
+    }
+
+    static uint64_t next_pool_id() {
+        static std::atomic<uint64_t> counter{0};
+        return ++counter;
+    }
+
+    /**
+     * Thread Cache Lookup
+     * ------------------
+     * Lock-free after the first call from each thread; registering a new
+     * cache takes the registry lock once per (thread, pool) pair.
+     */
+    ThreadCache& local_cache() {
+        static thread_local ThreadCacheTable table;
+        for (auto& entry : table.entries) {
+            if (entry.pool_id == pool_id) return *entry.cache;
+        }
+
+        std::lock_guard<std::mutex> lock(cache_registry_mutex());
+        // Drop entries of pools destroyed since this thread last registered
+        for (size_t i = 0; i < table.entries.size();) {
+            if (!table.entries[i].cache->pool) {
+                table.entries[i] = std::move(table.entries.back());
+                table.entries.pop_back();
+            } else {
+                ++i;
+            }
+        }
+        table.entries.push_back({pool_id, std::make_unique<ThreadCache>(this)});
+        ThreadCache* cache = table.entries.back().cache.get();
+        caches.push_back(cache);
+        return *cache;
+    }
+
+    /**
+     * Magazine Refill / Flush
+     * ----------------------
+     * The only places the cached path touches central state; each moves
+     * up to CACHE_BATCH blocks under a single lock acquisition.
+     */
+    void* refill_magazine(ThreadCache& cache, size_t cls) {
+        size_t block_size = size_t(1) << (cls + MIN_CACHE_CLASS);
+        std::lock_guard<std::mutex> lock(central_mutex);
+        auto& magazine = cache.magazines[cls];
+        size_t& count = cache.counts[cls];
+        void* first = allocate_block(block_size);
+        if (!first) {
+            flush_all_locked(cache);
+            return allocate_block(block_size);
+        }
+        while (count < CACHE_BATCH) {
+            void* block = allocate_block(block_size);
+            if (!block) break;
+            magazine[count++] = block;
+        }
+        return first;
+    }
+
+    void flush_magazine(ThreadCache& cache, size_t cls, size_t keep) {
+        std::lock_guard<std::mutex> lock(central_mutex);
+        while (cache.counts[cls] > keep) {
+            release_block(cache.magazines[cls][--cache.counts[cls]]);
+        }
+    }
+
+    void flush_all_locked(ThreadCache& cache) {
+        for (size_t cls = 0; cls < CACHE_CLASSES; ++cls) {
+            while (cache.counts[cls] > 0) {
+                release_block(cache.magazines[cls][--cache.counts[cls]]);
+            }
+        }
+    }
+
+    /**
+     * Thread Exit Handling
+     * -------------------
+     * Called with the registry lock held when a thread's cache table is
+     * destroyed: returns its blocks and unregisters the cache.
+     */
+    void retire_cache(ThreadCache* cache) {
+        {
+            std::lock_guard<std::mutex> lock(central_mutex);
+            flush_all_locked(*cache);
+        }
+        for (size_t i = 0; i < caches.size(); ++i) {
+            if (caches[i] == cache) {
+                caches[i] = caches.back();
+                caches.pop_back();
+                break;
+            }
+        }
+        cache->pool = nullptr;
+    }
 
 public:
     /**
      * Constructor: Simulates physical memory initialization at boot time
      * @param size: Total memory pool size in bytes
-     * Allocates a contiguous memory region and creates initial free block
+     * @param config: Strategy, concurrency, backing, NUMA placement and
+     *                growth reservation
+     * Allocates a contiguous memory region and creates initial free block;
+     * with a reservation, `size` is the initial commit
+     * @throws: std::bad_alloc if the backing cannot be obtained,
+     *          std::system_error if NUMA binding fails,
+     *          std::invalid_argument for a buddy pool with a reservation
      */
-    MemoryPool(size_t size) : total_size(size), used_size(0) {
-        // Allocate raw memory buffer (analogous to physical RAM)
-        pool = new char[size];  
+    BasicMemoryPool(size_t size, const Config& config)
+        : memory(size, config.backing, config.numa_node, config.reserve), pool(memory.data()),
+          total_size(size & ~(ALIGNMENT - 1)), reserve_limit(total_size), committed_size(total_size),
+          used_size(0), block_count(1), free_blocks(1),
+          strategy(Policy::strategy.value_or(config.strategy)),
+          concurrency(Policy::concurrency.value_or(config.concurrency)),
+          pool_id(next_pool_id()), bin_map(0), compact_cursor(0), compact_pass_clean(true),
+          compacted_blocks(0), compacted_bytes(0), grow_count(0), trim_epoch(0), released_bytes(0),
+          region_pins(0) {
+        if (total_size < MIN_BLOCK) {
+            throw std::invalid_argument("Memory pool too small for a single block");
+        }
+        if (config.reserve > size) {
+            if (strategy == Strategy::BUDDY) {
+                throw std::invalid_argument("Growable pools need a boundary-tag strategy");
+            }
+            reserve_limit = memory.reserved_size() & ~(ALIGNMENT - 1);
+        }
+        bins.fill(nullptr);
+        bin_counts.fill(0);
+
+        if (strategy == Strategy::BUDDY) {
+            buddy = std::make_unique<BuddyAllocator>(pool, total_size);
+            total_size = buddy->size();
+            return;
+        }
         // Create initial free block spanning entire pool
-        blocks.push_back(MemoryBlock(size, pool));
+        BlockTag* initial = reinterpret_cast<BlockTag*>(pool);
+        write_tags(initial, total_size, 0);
+        if (is_segregated()) bin_insert(initial);
+
+        if (reserve_limit / ALIGNMENT >= NO_BLOCK) {
+            throw std::invalid_argument("Memory pool too large for boundary-tag strategies");
+        }
+        size_t chunks = (total_size + EXTENT_CHUNK - 1) / EXTENT_CHUNK;
+        extents.reset(chunks);
+        chunk_first.assign(chunks, NO_BLOCK);
+        chunk_stale.assign(chunks, 0);
+        note_boundary(initial);
+        extent_raise(initial);
     }
 
+    /**
+     * Convenience Constructor
+     * ----------------------
+     * @param size: Total memory pool size in bytes
+     * @param strategy: Allocation strategy (first-fit unless specified)
+     * @param concurrency: Whether the pool may be shared between threads
+     */
+    BasicMemoryPool(size_t size, Strategy strategy = Strategy::FIRST_FIT,
+                    Concurrency concurrency = Concurrency::SINGLE_THREADED)
+        : BasicMemoryPool(size, Config{strategy, concurrency, Backing::HEAP, -1}) {}
+
+    BasicMemoryPool(const BasicMemoryPool&) = delete;
+    BasicMemoryPool& operator=(const BasicMemoryPool&) = delete;
+
     /**
      * Destructor: Memory cleanup similar to system shutdown
      * Releases the entire memory pool back to the system
      */
-    ~MemoryPool() {
-        delete[] pool;  // Release raw memory buffer
+    ~BasicMemoryPool() {
+        // Orphan thread caches; their blocks die with the pool memory
+        {
+            std::lock_guard<std::mutex> lock(cache_registry_mutex());
+            for (ThreadCache* cache : caches) cache->pool = nullptr;
+        }
+        // Pool memory is released by the BackingStore member
     }
 
     /**
      * Memory Allocation Method
      * -----------------------
      * Simulates virtual memory allocation in real OS:
-     * 1. Searches for suitable free block (first-fit)
+     * 1. Searches for suitable free block (first-fit, size-class bins or buddy)
      * 2. Splits block if significantly larger than requested
      * 3. Updates allocation metadata
      * 
      * @param size: Requested allocation size in bytes
+     * @param alignment: Required data alignment (power of two), e.g. 64 for
+     *                   cache lines/SIMD or 4096 for DMA pages
      * @return: Pointer to allocated memory region
-     * @throws: std::bad_alloc if no suitable block found
+     * @throws: std::bad_alloc if no suitable block found,
+     *          std::invalid_argument if alignment is not a power of two
      */
-    void* allocate(size_t size) {
-        if (size == 0) return nullptr;  // Handle zero-size request
+    void* allocate(size_t size, size_t alignment = DEFAULT_ALIGNMENT) {
+        if constexpr (!Policy::collect_stats) {
+            return allocate_untimed(size, alignment);
+        } else {
+            // Two clock reads cost more than a magazine pop, so only sample
+            static thread_local uint32_t calls = 0;
+            if (++calls % LATENCY_SAMPLE_INTERVAL != 0) return allocate_untimed(size, alignment);
 
-        // Linear search for first suitable block (first-fit algorithm)
-        for (auto& block : blocks) {
-            if (!block.is_allocated && block.size >= size) {
-                // Split block if remaining size worth tracking
-                if (block.size > size + sizeof(MemoryBlock)) {
-                    // Calculate remaining block size
-                    size_t remaining_size = block.size - size;
-                    // Update current block size
-                    block.size = size;
-                    // Create new block from remaining space
-                    blocks.push_back(MemoryBlock(remaining_size, block.data + size));
-                }
-
-                // Mark block as allocated and update usage stats
-                block.is_allocated = true;
-                used_size += block.size;
-                return block.data;
-            }
+            auto start = std::chrono::steady_clock::now();
+            void* data = allocate_untimed(size, alignment);
+            counters.allocate_latency.record(static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count()));
+            return data;
         }
-
-        throw std::bad_alloc();  // No suitable block found
     }
 
     /**
      * Memory Deallocation Method
      * -------------------------
      * Simulates memory freeing in real OS:
-     * 1. Locates block containing pointer
-     * 2. Marks block as free
-     * 3. Merges with adjacent free blocks (coalescing)
+     * 1. Locates block metadata directly from the pointer
+     * 2. Marks block as free (or parks it in this thread's magazine)
+     * 3. Merges with free neighbours (physical or buddy) to coalesce
      * 
      * @param ptr: Pointer to previously allocated memory
      */
     void deallocate(void* ptr) {
-        if (!ptr) return;  // Handle null pointer
+        if (!ptr || !owns(ptr)) return;  // Handle null and foreign pointers
+        BLOG(Logger::Level::DEBUG, "MemoryPool deallocate {}", ptr);
+        if constexpr (Policy::collect_stats) counters.frees.add(size_class(block_size_of(ptr)));
+
+        if (!is_concurrent()) {
+            release_block(ptr);
+            return;
+        }
+
+        // Fast path: push onto this thread's magazine without locking
+        size_t cls = cache_class_of(ptr);
+        if (cls < CACHE_CLASSES) {
+            ThreadCache& cache = local_cache();
+            if (cache.counts[cls] == MAGAZINE_CAPACITY) {
+                flush_magazine(cache, cls, MAGAZINE_CAPACITY - CACHE_BATCH);
+            }
+            cache.magazines[cls][cache.counts[cls]++] = ptr;
+            return;
+        }
+
+        std::lock_guard<std::mutex> lock(central_mutex);
+        release_block(ptr);
+    }
+
+    /**
+     * Thread Cache Flush
+     * -----------------
+     * Returns every block cached by the calling thread to the central pool,
+     * e.g. before a thread goes idle or before inspecting fragmentation.
+     */
+    void flush_thread_cache() {
+        if (!is_concurrent()) return;
+        ThreadCache& cache = local_cache();
+        std::lock_guard<std::mutex> lock(central_mutex);
+        flush_all_locked(cache);
+    }
+
+    /**
+     * Movable Allocation
+     * -----------------
+     * Like allocate(), but the block may be relocated by compaction, so
+     * the caller keeps a Handle and pins it to get an address. Served by
+     * the central pool, never by thread magazines.
+     * @param size: Requested allocation size in bytes
+     * @return: Handle to the block (a null Handle for size 0)
+     * @throws: std::bad_alloc if no suitable block found,
+     *          std::invalid_argument for the buddy strategy
+     */
+    Handle allocate_movable(size_t size) {
+        if (is_buddy()) throw std::invalid_argument("Movable blocks need a boundary-tag strategy");
+        if (size == 0) return Handle{};
 
-        // Find block containing this pointer
-        auto it = std::find_if(blocks.begin(), blocks.end(),
-            [ptr](const MemoryBlock& block) { return block.data == ptr; });
+        auto lock = central_lock();
+        void* data = allocate_block(block_size_for(size));
+        if (!data) allocation_failed();
 
-        if (it != blocks.end()) {
-            // Mark block as free and update usage stats
-            it->is_allocated = false;
-            used_size -= it->size;
+        uint32_t index;
+        if (!free_handle_slots.empty()) {
+            index = free_handle_slots.back();
+            free_handle_slots.pop_back();
+        } else {
+            index = static_cast<uint32_t>(handle_table.size());
+            handle_table.push_back({nullptr, 0, 0});
+        }
+        HandleSlot& slot = handle_table[index];
+        slot.data = data;
+        slot.pins = 0;
+        BlockTag* block = header_of(data);
+        write_tags(block, block->size, ALLOCATED | MOVABLE, index);
+        traced(data, size);
+        return Handle{index, slot.generation};
+    }
 
-            // Merge with next block if it's free (coalescing)
-            auto next = std::next(it);
-            if (next != blocks.end() && !next->is_allocated) {
-                // Combine block sizes
-                it->size += next->size;
-                // Remove absorbed block
-                blocks.erase(next);
+    /**
+     * Pinning
+     * ------
+     * pin() returns the block's current address and keeps compaction from
+     * moving it until a matching unpin(); pins nest
+     * @return: Block address, or nullptr for a stale or null handle
+     */
+    void* pin(Handle handle) {
+        auto lock = central_lock();
+        HandleSlot* slot = resolve(handle);
+        if (!slot) return nullptr;
+        ++slot->pins;
+        return slot->data;
+    }
+
+    void unpin(Handle handle) {
+        auto lock = central_lock();
+        HandleSlot* slot = resolve(handle);
+        if (slot && slot->pins > 0 && --slot->pins == 0) compact_pass_clean = false;
+    }
+
+    /**
+     * Movable Deallocation
+     * -------------------
+     * Frees the block behind `handle`, pinned or not; the handle and any
+     * copies of it go stale
+     */
+    void deallocate(Handle handle) {
+        auto lock = central_lock();
+        HandleSlot* slot = resolve(handle);
+        if (!slot) return;
+        void* data = slot->data;
+        BLOG(Logger::Level::DEBUG, "MemoryPool deallocate {}", data);
+        if constexpr (Policy::collect_stats) counters.frees.add(size_class(block_size_of(data)));
+        slot->data = nullptr;
+        slot->pins = 0;
+        ++slot->generation;
+        free_handle_slots.push_back(handle.slot);
+        release_block(data);
+    }
+
+    /**
+     * Incremental Compaction
+     * ---------------------
+     * Continues the current pass from where the last step stopped: each
+     * free block with an unpinned movable block behind it swaps places
+     * with that block. Fixed and pinned blocks stay put, so free space
+     * gathers in front of them and at the pool end. Returns once `budget`
+     * has elapsed (after at least one move or skip) or when a whole pass
+     * ran without moving anything and without the pool changing under it.
+     * @param budget: Time to spend, e.g. 50us between request batches
+     * @return: What this step did, and whether compaction is complete
+     */
+    CompactionProgress compact_step(std::chrono::nanoseconds budget) {
+        CompactionProgress progress;
+        if (is_buddy()) {
+            progress.complete = true;  // Buddy blocks have fixed positions
+            return progress;
+        }
+
+        auto lock = central_lock();
+        auto deadline = std::chrono::steady_clock::now() + budget;
+        for (;;) {
+            BlockTag* hole = next_hole(compact_cursor);
+            BlockTag* block = hole ? next_block(hole) : nullptr;  // Never free: holes are coalesced
+            if (!block) {
+                bool idle = compact_pass_clean;
+                compact_cursor = 0;
+                compact_pass_clean = true;
+                if (idle) {
+                    progress.complete = true;
+                    break;
+                }
+            } else if ((block->flags & MOVABLE) && handle_table[block->reserved].pins == 0) {
+                progress.bytes_moved += block->size;
+                ++progress.blocks_moved;
+                compact_pass_clean = false;
+                compact_cursor = static_cast<size_t>(reinterpret_cast<char*>(slide_down(hole, block)) - pool);
+            } else {
+                compact_cursor = static_cast<size_t>(reinterpret_cast<char*>(block) - pool) + block->size;
+            }
+            if (std::chrono::steady_clock::now() >= deadline) break;
+        }
+        compacted_blocks += progress.blocks_moved;
+        compacted_bytes += progress.bytes_moved;
+        MEMORY_POOL_CHECK();
+        return progress;
+    }
+
+    /**
+     * Full Compaction
+     * --------------
+     * Runs compact_step() in 1 ms slices until complete, releasing the
+     * central lock in between so concurrent users are not stalled
+     */
+    CompactionProgress compact() {
+        CompactionProgress total;
+        while (!total.complete) {
+            CompactionProgress step = compact_step(std::chrono::milliseconds(1));
+            total.blocks_moved += step.blocks_moved;
+            total.bytes_moved += step.bytes_moved;
+            total.complete = step.complete;
+        }
+        return total;
+    }
+
+    /**
+     * Idle Page Release
+     * ----------------
+     * Each call closes one trim epoch. Free blocks are stamped with the
+     * epoch they were freed (or last merged) in; a block that has stayed
+     * free for at least `min_idle` epochs gets the whole pages inside it
+     * returned to the OS with MADV_DONTNEED. Its tags and free-list links
+     * stay resident, so the pool itself never notices; released pages
+     * refault as zero pages when the block is used again.
+     *
+     * The extent tree skips chunks without a page-sized free block.
+     * While the region is pinned nothing is released (the epoch still
+     * advances): an I/O engine holding the old pages would no longer see
+     * the memory the pool hands out.
+     * @param min_idle: Earlier trim() calls the block must have survived
+     *                  free (0 releases every free block now)
+     * @return: Bytes released by this call
+     */
+    size_t trim(uint32_t min_idle = 1) {
+        auto lock = central_lock();
+        if (is_buddy()) return 0;
+        if (region_pins > 0) {
+            if (++trim_epoch == RELEASED) trim_epoch = 0;
+            return 0;
+        }
+
+        size_t page = memory.granule(), released = 0;
+        settle_extents();
+        for (size_t chunk = extents.find(0, units(page)); chunk < extents.size();
+             chunk = extents.find(chunk + 1, units(page))) {
+            char* high = pool + (chunk + 1) * EXTENT_CHUNK;
+            for (BlockTag* block = chunk_head(chunk); block && reinterpret_cast<char*>(block) < high;
+                 block = next_block(block)) {
+                if (!is_free(block) || block->size < page || block->reserved == RELEASED) continue;
+                if (trim_epoch - block->reserved < min_idle) continue;
+                char* interior = data_of(block) + sizeof(FreeLinks);
+                released += memory.release_pages(interior, reinterpret_cast<char*>(footer_of(block)));
+                block->reserved = RELEASED;
+                footer_of(block)->reserved = RELEASED;
             }
         }
+        if (++trim_epoch == RELEASED) trim_epoch = 0;
+        released_bytes += released;
+        return released;
+    }
+
+    /**
+     * Consistency Validation Method
+     * ----------------------------
+     * Walks the address-ordered block chain and the free bins, verifying:
+     * 1. Blocks tile the pool exactly, each aligned and at least MIN_BLOCK
+     * 2. Every header matches its footer
+     * 3. No two free blocks are adjacent (coalescing is complete)
+     * 4. Block count and used bytes match the running totals
+     * 5. Each bin lists only free blocks of its own class, with intact
+     *    links, and together the bins hold every free block
+     * 
+     * The buddy strategy delegates to BuddyAllocator::validate().
+     * Blocks parked in thread magazines count as allocated.
+     * 
+     * @throws: std::logic_error describing the first violated invariant
+     */
+    void validate() const {
+        auto lock = central_lock();
+        check_invariants();
     }
 
     /**
@@ -168,22 +1592,33 @@ public:
      * - 0.0 indicates perfect contiguous free space
      * - 1.0 indicates completely fragmented memory
      * 
+     * O(1): the largest free block is tracked incrementally.
+     * 
      * @return: Fragmentation ratio between 0.0 and 1.0
      */
     double fragmentation_ratio() const {
-        size_t largest_free_block = 0;
-        size_t total_free = total_size - used_size;
+        auto lock = central_lock();
+        return compute_fragmentation();
+    }
 
-        // Find largest contiguous free block
-        for (const auto& block : blocks) {
-            if (!block.is_allocated && block.size > largest_free_block) {
-                largest_free_block = block.size;
-            }
-        }
+    /**
+     * Free Space Queries
+     * -----------------
+     * O(1) snapshots of the incrementally tracked free-space shape
+     */
+    size_t largest_free_block() const {
+        auto lock = central_lock();
+        return largest_free();
+    }
 
-        // Calculate fragmentation ratio
-        return total_free > 0 ? 
-            1.0 - (static_cast<double>(largest_free_block) / total_free) : 0.0;
+    size_t bytes_used() const {
+        auto lock = central_lock();
+        return used_bytes();
+    }
+
+    size_t free_block_count() const {
+        auto lock = central_lock();
+        return free_block_total();
     }
 
     /**
@@ -194,14 +1629,294 @@ public:
      * - Currently used memory
      * - Free memory amount
      * - Fragmentation percentage
-     * - Number of memory blocks
+     * - Number of memory blocks, free blocks and the largest free block
+     * - Movable blocks and compaction totals (when any were allocated)
+     * - Free blocks per size-class bin (segregated-fit only)
+     * - Registered thread caches (concurrent only)
      */
     void print_stats() const {
+        // Registry before central: same lock order as thread-exit retirement
+        size_t cache_count = 0;
+        if (is_concurrent()) {
+            std::lock_guard<std::mutex> registry(cache_registry_mutex());
+            cache_count = caches.size();
+        }
+
+        auto lock = central_lock();
         std::cout << "Memory Pool Stats:\n"
-                  << "Total Size: " << total_size << " bytes\n"
-                  << "Used Size: " << used_size << " bytes\n"
-                  << "Free Size: " << (total_size - used_size) << " bytes\n"
-                  << "Fragmentation: " << (fragmentation_ratio() * 100) << "%\n"
-                  << "Number of blocks: " << blocks.size() << "\n";
+                  << "Strategy: " << strategy_name(active_strategy()) << "\n"
+                  << "Backing: " << BackingStore::backing_name(memory.active_backing())
+                  << " (base alignment " << memory.base_alignment() << ")\n";
+        if (memory.numa_node() >= 0) {
+            std::cout << "NUMA Node: " << memory.numa_node() << "\n";
+        }
+        std::cout << "Total Size: " << total_size << " bytes\n"
+                  << "Used Size: " << used_bytes() << " bytes\n"
+                  << "Free Size: " << (total_size - used_bytes()) << " bytes\n"
+                  << "Fragmentation: " << (compute_fragmentation() * 100) << "%\n"
+                  << "Number of blocks: " << total_blocks() << "\n"
+                  << "Free blocks: " << free_block_total()
+                  << " (largest " << largest_free() << " bytes)\n";
+        if (reserve_limit > total_size || grow_count) {
+            std::cout << "Reserved Size: " << reserve_limit << " bytes (grown " << grow_count << " times)\n";
+        }
+        if (released_bytes) {
+            std::cout << "Released to OS: " << released_bytes << " bytes\n";
+        }
+
+        if (!handle_table.empty()) {
+            size_t pinned = 0;
+            for (const HandleSlot& slot : handle_table) pinned += slot.data && slot.pins;
+            std::cout << "Movable blocks: " << (handle_table.size() - free_handle_slots.size())
+                      << " (" << pinned << " pinned)\n"
+                      << "Compaction: " << compacted_blocks << " blocks, "
+                      << compacted_bytes << " bytes moved\n";
+        }
+
+        if (is_concurrent()) {
+            std::cout << "Thread caches: " << cache_count << "\n";
+        }
+
+        if (is_segregated()) {
+            std::cout << "Free blocks per bin:\n";
+            for (size_t bin = 0; bin < NUM_BINS; ++bin) {
+                if (bin_counts[bin] == 0) continue;
+                std::cout << "  [" << (size_t(1) << bin) << ", ";
+                if (bin + 1 < NUM_BINS) std::cout << (size_t(1) << (bin + 1));
+                else std::cout << "max";
+                std::cout << "): " << bin_counts[bin] << "\n";
+            }
+        }
+
+        if (is_buddy()) {
+            std::cout << "Free blocks per order:\n";
+            for (size_t order = buddy->min_order(); order <= buddy->top_order(); ++order) {
+                if (buddy->free_blocks_at(order) == 0) continue;
+                std::cout << "  [" << (size_t(1) << order) << "]: "
+                          << buddy->free_blocks_at(order) << "\n";
+            }
+        }
     }
-};
\ No newline at end of file
+
+    /**
+     * Metrics Export
+     * -------------
+     * Appends this pool's counters, latency histogram and usage gauges to
+     * a snapshot. Size classes are labelled by their lower bound in bytes;
+     * classes never used are left out. Without stats collection only the
+     * gauges and compaction/growth totals are written.
+     */
+    void export_metrics(MetricsWriter& writer) const {
+        if constexpr (Policy::collect_stats) {
+            MetricsWriter::LabelledValues allocated, freed;
+            for (size_t cls = 0; cls < NUM_BINS; ++cls) {
+                uint64_t out = counters.allocations.value(cls), back = counters.frees.value(cls);
+                if (out == 0 && back == 0) continue;
+                std::string label = std::to_string(size_t(1) << cls);
+                allocated.emplace_back(label, out);
+                freed.emplace_back(label, back);
+            }
+            writer.counters("pool_allocations_total", "Blocks allocated by block size class.", "size_class", allocated);
+            writer.counters("pool_frees_total", "Blocks freed by block size class.", "size_class", freed);
+            writer.counter("pool_allocation_failures_total", "Allocations that threw bad_alloc.",
+                           counters.allocation_failures.value(0));
+            writer.histogram("pool_allocate_latency_ns", "Sampled allocate() latency in nanoseconds.",
+                             counters.allocate_latency.snapshot());
+        }
+
+        size_t used, moved_blocks, moved_bytes, capacity, grows, released;
+        {
+            auto lock = central_lock();
+            used = used_bytes();
+            moved_blocks = compacted_blocks;
+            moved_bytes = compacted_bytes;
+            capacity = total_size;
+            grows = grow_count;
+            released = released_bytes;
+        }
+
+        writer.counter("pool_compaction_moves_total", "Movable blocks relocated by compaction.", moved_blocks);
+        writer.counter("pool_compaction_bytes_total", "Bytes copied by compaction.", moved_bytes);
+        writer.counter("pool_grows_total", "Times the pool committed more of its reservation.", grows);
+        writer.counter("pool_released_bytes_total", "Bytes of idle free blocks returned to the OS by trim().", released);
+        writer.gauge("pool_capacity_bytes", "Pool size in bytes.", static_cast<double>(capacity));
+        writer.gauge("pool_reserved_bytes", "Size the pool may grow to.", static_cast<double>(reserve_limit));
+        writer.gauge("pool_used_bytes", "Bytes in allocated blocks, tags included.", static_cast<double>(used));
+        writer.gauge("pool_fragmentation_ratio", "1 - largest free block / free bytes.", fragmentation_ratio());
+    }
+
+    /**
+     * Region Accessors
+     * ---------------
+     * Pool geometry and mode, e.g. for registering the whole region with an
+     * I/O engine so pool blocks can be used as DMA-style buffers.
+     * capacity() is the committed size, which a growable pool raises up
+     * to reserved_capacity(); region() never moves.
+     */
+    char* region() const { return pool; }
+    size_t capacity() const { return committed_size.load(std::memory_order_relaxed); }
+    size_t reserved_capacity() const { return reserve_limit; }
+    Concurrency concurrency_mode() const { return is_concurrent() ? Concurrency::CONCURRENT : Concurrency::SINGLE_THREADED; }
+
+    /**
+     * Usable Block Size
+     * ----------------
+     * For callers handing a block to code that trusts a length, e.g. the
+     * device driver's zero-copy payloads.
+     * @return: Bytes usable from `ptr` to the end of its block, or 0 if
+     *          `ptr` is not a live (non-movable) allocation of this pool
+     */
+    size_t usable_size(void* ptr) const {
+        if (!ptr || !owns(ptr)) return 0;
+        return is_buddy() ? block_size_of(ptr) : block_size_of(ptr) - 2 * TAG_SIZE;
+    }
+
+    /**
+     * Region Pinning
+     * -------------
+     * Registering the region with an I/O engine (an io_uring fixed buffer)
+     * pins its current physical pages; if trim() dropped them the user
+     * mapping would refault fresh zero pages the engine never sees. Pins
+     * nest; trim() releases nothing until every pin is dropped. Taken
+     * under the central lock, so no trim() is mid-release on return.
+     */
+    void pin_region() {
+        auto lock = central_lock();
+        ++region_pins;
+    }
+
+    void unpin_region() {
+        auto lock = central_lock();
+        if (region_pins > 0) --region_pins;
+    }
+
+    bool region_pinned() const {
+        auto lock = central_lock();
+        return region_pins > 0;
+    }
+
+private:
+    /**
+     * Invariant Check (see validate)
+     * -----------------------------
+     * Caller holds central_mutex when CONCURRENT.
+     */
+    void check_invariants() const {
+        if (is_buddy()) {
+            buddy->validate();
+            return;
+        }
+
+        auto fail = [](const std::string& what, const void* where) {
+            throw std::logic_error("MemoryPool corrupt: " + what + " at block " +
+                                   std::to_string(reinterpret_cast<uintptr_t>(where)));
+        };
+
+        if (committed_size.load(std::memory_order_relaxed) != total_size || total_size > reserve_limit ||
+            total_size > memory.size()) {
+            fail("pool size out of step with its commit", pool);
+        }
+
+        size_t blocks_seen = 0, used_seen = 0, free_seen = 0, movable_seen = 0;
+        bool prev_free = false;
+        char* cursor = pool;
+        while (cursor < pool + total_size) {
+            BlockTag* block = reinterpret_cast<BlockTag*>(cursor);
+            size_t room = static_cast<size_t>(pool + total_size - cursor);
+            if (block->size < MIN_BLOCK || block->size % ALIGNMENT != 0 || block->size > room) {
+                fail("bad block size " + std::to_string(block->size), block);
+            }
+            const BlockTag* footer = footer_of(block);
+            if (footer->size != block->size || footer->flags != block->flags ||
+                footer->reserved != block->reserved) {
+                fail("header/footer mismatch", block);
+            }
+            if (block->flags & MOVABLE) {
+                if (block->reserved >= handle_table.size() ||
+                    handle_table[block->reserved].data != data_of(block)) {
+                    fail("movable block without its handle", block);
+                }
+                ++movable_seen;
+            }
+            bool free_block = is_free(block);
+            if (free_block && prev_free) fail("adjacent free blocks", block);
+            if (free_block) ++free_seen;
+            else used_seen += block->size;
+            prev_free = free_block;
+            ++blocks_seen;
+            cursor += block->size;
+        }
+
+        if (cursor != pool + total_size) fail("chain overruns pool end", cursor);
+        if (blocks_seen != block_count) fail("block count mismatch", pool);
+        if (used_seen != used_size) fail("used size mismatch", pool);
+        if (free_seen != free_blocks) fail("free block count mismatch", pool);
+        if (movable_seen != handle_table.size() - free_handle_slots.size()) {
+            fail("handle count mismatch", pool);
+        }
+
+        // Extent tree: chunk heads exact; leaves exact unless marked stale,
+        // and never below what a fresh walk of the chain finds
+        std::vector<uint32_t> leaf_max(extents.size(), 0), leaf_first(extents.size(), NO_BLOCK);
+        uint32_t largest = 0;
+        for (BlockTag* block = reinterpret_cast<BlockTag*>(pool); block; block = next_block(block)) {
+            size_t chunk = chunk_of(block);
+            if (leaf_first[chunk] == NO_BLOCK) leaf_first[chunk] = offset_of(block);
+            if (is_free(block)) {
+                leaf_max[chunk] = std::max(leaf_max[chunk], units(block->size));
+                largest = std::max(largest, units(block->size));
+            }
+        }
+        size_t stale_seen = 0;
+        for (size_t chunk = 0; chunk < extents.size(); ++chunk) {
+            const char* where = pool + chunk * EXTENT_CHUNK;
+            uint32_t leaf = extents.get(chunk);
+            if (leaf < leaf_max[chunk] || (leaf != leaf_max[chunk] && !chunk_stale[chunk])) {
+                fail("stale extent leaf", where);
+            }
+            if (chunk_first[chunk] != leaf_first[chunk]) fail("stale chunk head", where);
+            if (leaf && extents.find(chunk, leaf) != chunk) fail("extent search mismatch", where);
+            stale_seen += chunk_stale[chunk];
+        }
+        if (stale_seen != stale_chunks.size()) fail("stale chunk list mismatch", pool);
+        if (extents.max() < largest || (stale_chunks.empty() && extents.max() != largest)) {
+            fail("stale extent root", pool);
+        }
+        if (!is_segregated()) return;
+
+        size_t binned = 0;
+        for (size_t bin = 0; bin < NUM_BINS; ++bin) {
+            size_t count = 0;
+            BlockTag* prev = nullptr;
+            for (BlockTag* block = bins[bin]; block; block = links_of(block)->next) {
+                if (!is_free(block)) fail("allocated block in bin", block);
+                if (size_class(block->size) != bin) fail("block in wrong bin", block);
+                if (links_of(block)->prev != prev) fail("broken bin links", block);
+                if (++count > free_seen) fail("cycle in bin", block);
+                prev = block;
+            }
+            if (count != bin_counts[bin]) fail("bin count mismatch", bins[bin]);
+            if (((bin_map >> bin) & 1) != (count > 0 ? 1u : 0u)) fail("bin map mismatch", bins[bin]);
+            binned += count;
+        }
+        if (binned != free_seen) fail("free block missing from bins", pool);
+    }
+
+    /**
+     * Fragmentation Computation (see fragmentation_ratio)
+     * --------------------------------------------------
+     * Caller holds central_mutex when CONCURRENT.
+     */
+    double compute_fragmentation() const {
+        size_t total_free = total_size - used_bytes();
+        return total_free > 0 ?
+            1.0 - (static_cast<double>(largest_free()) / total_free) : 0.0;
+    }
+};
+
+/**
+ * Runtime-Configured Pool
+ * ----------------------
+ * Every choice comes from Config, as before policies existed
+ */
+using MemoryPool = BasicMemoryPool<DefaultPoolPolicy>;
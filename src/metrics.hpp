@@ -0,0 +1,387 @@
+/*******************************************************************************
+ * Hot-Path Metrics
+ * ---------------
+ * Always-on counters and histograms for the allocator and the device queue,
+ * cheap enough to leave enabled (in the spirit of per-CPU vmstat counters):
+ *
+ * I. Concepts Demonstrated:
+ * 1. Striped Counters
+ *    - Each thread updates its own cache-line-padded stripe, so hot-path
+ *      increments never bounce a shared line between cores
+ *    - A stripe has a single writer, so an increment is a plain load and
+ *      store rather than a locked read-modify-write
+ *    - Readers sum the stripes; a snapshot is approximate only while
+ *      writers are running
+ *
+ * 2. Log-Linear Histograms
+ *    - Bucket k counts values in [2^(k-1), 2^k), bucket 0 counts zero
+ *    - Recording is one bit scan and two relaxed increments
+ *    - Percentiles are reported as the upper bound of their bucket
+ *
+ * 3. Machine-Readable Export
+ *    - MetricsWriter renders one snapshot as JSON or Prometheus text
+ *
+ * Implementation Notes:
+ * - A thread claims a stripe slot on first use and returns it on exit;
+ *   threads beyond the first METRIC_STRIPES - 1 share the last stripe,
+ *   which is updated with fetch_add
+ * - All updates are relaxed: counters order nothing, they only count
+ ******************************************************************************/
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+static constexpr size_t METRIC_STRIPES = 16;
+
+/**
+ * Thread Stripe Slot
+ * -----------------
+ * Process-wide stripe index of the calling thread, shared by every
+ * counter set. Exclusive slots are recycled when their thread exits.
+ */
+class MetricSlot {
+public:
+    static constexpr size_t SHARED = METRIC_STRIPES - 1;  // Slot for overflow threads
+
+private:
+    size_t index;
+
+    struct Registry {
+        std::mutex mutex;
+        uint32_t in_use = 0;  // Bit k set while slot k is owned
+    };
+
+    static Registry& registry() {
+        static Registry instance;
+        return instance;
+    }
+
+    MetricSlot() : index(SHARED) {
+        Registry& slots = registry();
+        std::lock_guard<std::mutex> lock(slots.mutex);
+        for (size_t slot = 0; slot < SHARED; ++slot) {
+            if (!(slots.in_use & (1u << slot))) {
+                slots.in_use |= 1u << slot;
+                index = slot;
+                break;
+            }
+        }
+    }
+
+public:
+    ~MetricSlot() {
+        if (index == SHARED) return;
+        Registry& slots = registry();
+        std::lock_guard<std::mutex> lock(slots.mutex);
+        slots.in_use &= ~(1u << index);
+    }
+
+    MetricSlot(const MetricSlot&) = delete;
+    MetricSlot& operator=(const MetricSlot&) = delete;
+
+    static size_t current() {
+        static thread_local MetricSlot slot;
+        return slot.index;
+    }
+};
+
+/**
+ * Striped Counter Set
+ * ------------------
+ * N related counters (e.g. one per size class) replicated per stripe
+ */
+template <size_t N>
+class StripedCounters {
+public:
+    static constexpr size_t CACHE_LINE = 64;
+
+private:
+    struct alignas(CACHE_LINE) Stripe {
+        std::array<std::atomic<uint64_t>, N> cells;
+    };
+
+    std::array<Stripe, METRIC_STRIPES> stripes;
+
+public:
+    StripedCounters() {
+        for (auto& stripe : stripes) {
+            for (auto& cell : stripe.cells) cell.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    StripedCounters(const StripedCounters&) = delete;
+    StripedCounters& operator=(const StripedCounters&) = delete;
+
+    void add(size_t counter, uint64_t amount = 1) {
+        size_t slot = MetricSlot::current();
+        std::atomic<uint64_t>& cell = stripes[slot].cells[counter];
+        if (slot == MetricSlot::SHARED) {
+            cell.fetch_add(amount, std::memory_order_relaxed);
+        } else {
+            cell.store(cell.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+    }
+
+    uint64_t value(size_t counter) const {
+        uint64_t total = 0;
+        for (const auto& stripe : stripes) total += stripe.cells[counter].load(std::memory_order_relaxed);
+        return total;
+    }
+
+    static constexpr size_t size() { return N; }
+};
+
+using StripedCounter = StripedCounters<1>;
+
+/**
+ * Histogram
+ * --------
+ * Power-of-two buckets over uint64_t values (nanoseconds, queue depths);
+ * the last cell of each stripe holds the running sum
+ */
+class Histogram {
+public:
+    static constexpr size_t BUCKETS = 65;  // Zero plus one per bit width
+
+    struct Snapshot {
+        std::array<uint64_t, BUCKETS> buckets{};  // Count per bucket
+        uint64_t count = 0;                       // Values recorded
+        uint64_t sum = 0;                         // Sum of values recorded
+
+        // Inclusive upper bound of bucket k
+        static uint64_t bucket_limit(size_t bucket) {
+            return bucket >= 64 ? UINT64_MAX : (uint64_t(1) << bucket) - 1;
+        }
+
+        /**
+         * Percentile Lookup
+         * ----------------
+         * @param quantile: 0.0 .. 1.0
+         * @return: Upper bound of the bucket holding the nearest-rank
+         *          value (0 if empty)
+         */
+        uint64_t percentile(double quantile) const {
+            if (count == 0) return 0;
+            uint64_t rank = static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count)));
+            if (rank == 0) rank = 1;
+            uint64_t seen = 0;
+            for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+                seen += buckets[bucket];
+                if (seen >= rank) return bucket_limit(bucket);
+            }
+            return bucket_limit(BUCKETS - 1);
+        }
+
+        double mean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+    };
+
+private:
+    StripedCounters<BUCKETS + 1> cells;
+
+    static size_t bucket_of(uint64_t value) {
+        return value == 0 ? 0 : 64 - static_cast<size_t>(__builtin_clzll(value));
+    }
+
+public:
+    void record(uint64_t value) {
+        cells.add(bucket_of(value));
+        cells.add(BUCKETS, value);
+    }
+
+    Snapshot snapshot() const {
+        Snapshot result;
+        for (size_t bucket = 0; bucket < BUCKETS; ++bucket) {
+            result.buckets[bucket] = cells.value(bucket);
+            result.count += result.buckets[bucket];
+        }
+        result.sum = cells.value(BUCKETS);
+        return result;
+    }
+};
+
+/**
+ * Metrics Writer
+ * -------------
+ * Accumulates one snapshot in the chosen text format. Names are given
+ * without prefix; Prometheus output prefixes them with "kernel_sim_".
+ *
+ * JSON shape:
+ *   {"name": value,
+ *    "labelled": {"label value": value, ...},
+ *    "histogram": {"count": c, "sum": s, "mean": m, "p50": .., "p90": ..,
+ *                  "p99": .., "max": .., "buckets": {"<le>": count, ...}}}
+ */
+class MetricsWriter {
+public:
+    enum class Format {
+        JSON,
+        PROMETHEUS
+    };
+
+    using LabelledValues = std::vector<std::pair<std::string, uint64_t>>;
+
+private:
+    Format format;
+    std::string out;
+    bool first = true;  // No JSON member written yet
+
+    // Shortest round-trip form, so integral gauges print as integers
+    static std::string number(double value) {
+        char buffer[32];
+        auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+        return std::string(buffer, result.ptr);
+    }
+
+    void json_key(std::string_view name) {
+        out += first ? "{\n  \"" : ",\n  \"";
+        out.append(name.data(), name.size());
+        out += "\": ";
+        first = false;
+    }
+
+    void prometheus_header(std::string_view name, std::string_view help, const char* type) {
+        out += "# HELP kernel_sim_";
+        out.append(name.data(), name.size());
+        out += ' ';
+        out.append(help.data(), help.size());
+        out += "\n# TYPE kernel_sim_";
+        out.append(name.data(), name.size());
+        out += ' ';
+        out += type;
+        out += '\n';
+    }
+
+    void prometheus_sample(std::string_view name, std::string_view suffix,
+                           std::string_view labels, const std::string& value) {
+        out += "kernel_sim_";
+        out.append(name.data(), name.size());
+        out.append(suffix.data(), suffix.size());
+        if (!labels.empty()) {
+            out += '{';
+            out.append(labels.data(), labels.size());
+            out += '}';
+        }
+        out += ' ';
+        out += value;
+        out += '\n';
+    }
+
+    void scalar(std::string_view name, std::string_view help, const char* type, const std::string& value) {
+        if (format == Format::JSON) {
+            json_key(name);
+            out += value;
+        } else {
+            prometheus_header(name, help, type);
+            prometheus_sample(name, "", "", value);
+        }
+    }
+
+public:
+    explicit MetricsWriter(Format fmt) : format(fmt) {}
+
+    /**
+     * Parse Format Name
+     * ----------------
+     * @return: False for anything but "json" or "prometheus"
+     */
+    static bool parse_format(std::string_view text, Format& fmt) {
+        if (text == "json") fmt = Format::JSON;
+        else if (text == "prometheus") fmt = Format::PROMETHEUS;
+        else return false;
+        return true;
+    }
+
+    void counter(std::string_view name, std::string_view help, uint64_t value) {
+        scalar(name, help, "counter", std::to_string(value));
+    }
+
+    void gauge(std::string_view name, std::string_view help, double value) {
+        scalar(name, help, "gauge", number(value));
+    }
+
+    /**
+     * Labelled Counter Family
+     * ----------------------
+     * One counter per label value, e.g. per size class
+     */
+    void counters(std::string_view name, std::string_view help, std::string_view label,
+                  const LabelledValues& values) {
+        if (format == Format::JSON) {
+            json_key(name);
+            out += '{';
+            for (size_t i = 0; i < values.size(); ++i) {
+                out += i ? ", \"" : "\"";
+                out += values[i].first + "\": " + std::to_string(values[i].second);
+            }
+            out += '}';
+            return;
+        }
+        prometheus_header(name, help, "counter");
+        for (const auto& entry : values) {
+            std::string labels(label);
+            labels += "=\"" + entry.first + "\"";
+            prometheus_sample(name, "", labels, std::to_string(entry.second));
+        }
+    }
+
+    /**
+     * Histogram
+     * --------
+     * Buckets above the highest non-empty one are omitted
+     */
+    void histogram(std::string_view name, std::string_view help, const Histogram::Snapshot& snapshot) {
+        size_t top = 0;
+        for (size_t bucket = 0; bucket < Histogram::BUCKETS; ++bucket) {
+            if (snapshot.buckets[bucket]) top = bucket;
+        }
+
+        if (format == Format::JSON) {
+            json_key(name);
+            out += "{\"count\": " + std::to_string(snapshot.count) +
+                   ", \"sum\": " + std::to_string(snapshot.sum) +
+                   ", \"mean\": " + number(snapshot.mean()) +
+                   ", \"p50\": " + std::to_string(snapshot.percentile(0.50)) +
+                   ", \"p90\": " + std::to_string(snapshot.percentile(0.90)) +
+                   ", \"p99\": " + std::to_string(snapshot.percentile(0.99)) +
+                   ", \"max\": " + std::to_string(snapshot.percentile(1.0)) +
+                   ", \"buckets\": {";
+            for (size_t bucket = 0; snapshot.count && bucket <= top; ++bucket) {
+                out += bucket ? ", \"" : "\"";
+                out += std::to_string(Histogram::Snapshot::bucket_limit(bucket)) + "\": " +
+                       std::to_string(snapshot.buckets[bucket]);
+            }
+            out += "}}";
+            return;
+        }
+
+        prometheus_header(name, help, "histogram");
+        uint64_t cumulative = 0;
+        for (size_t bucket = 0; snapshot.count && bucket <= top; ++bucket) {
+            cumulative += snapshot.buckets[bucket];
+            prometheus_sample(name, "_bucket",
+                              "le=\"" + std::to_string(Histogram::Snapshot::bucket_limit(bucket)) + "\"",
+                              std::to_string(cumulative));
+        }
+        prometheus_sample(name, "_bucket", "le=\"+Inf\"", std::to_string(snapshot.count));
+        prometheus_sample(name, "_sum", "", std::to_string(snapshot.sum));
+        prometheus_sample(name, "_count", "", std::to_string(snapshot.count));
+    }
+
+    /**
+     * Finished Text
+     * ------------
+     */
+    std::string str() const {
+        if (format == Format::PROMETHEUS) return out;
+        return first ? "{}\n" : out + "\n}\n";
+    }
+};
@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Bounded Lock-Free Ring Buffer
+ * ---------------------------
+ * Multi-producer multi-consumer queue used as the device request queue,
+ * after Dmitry Vyukov's bounded MPMC design:
+ *
+ * I. Concurrency Concepts Demonstrated:
+ * 1. Lock-Free Progress
+ *    - One CAS per push/pop on a shared position counter
+ *    - No mutex, no allocation after construction
+ *
+ * 2. Per-Slot Sequencing
+ *    - Every cell carries a sequence number that says whether it is ready
+ *      to be written (seq == pos) or read (seq == pos + 1)
+ *    - Producers and consumers only contend on the cell they claimed
+ *
+ * 3. Back-Pressure
+ *    - Fixed capacity; push fails when the ring is full instead of blocking
+ *
+ * 4. Batching
+ *    - Bulk push/pop claim a run of consecutive cells with a single CAS
+ *
+ * Implementation Notes:
+ * - Capacity need not be a power of two: cells are indexed pos % capacity
+ *   and a freed cell's sequence jumps to pos + capacity, which is exactly
+ *   the next position that maps onto it
+ * - Head and tail live on separate cache lines to avoid false sharing
+ * - size() is a racy snapshot, suitable for statistics and limits
+ *
+ * Cell Lifecycle:
+ * seq == pos        -> free, producer at `pos` may claim it
+ * seq == pos + 1    -> full, consumer at `pos` may claim it
+ * seq == pos + cap  -> free again for the next lap
+ ******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <stdexcept>
+
+template <typename T>
+class MpmcRingBuffer {
+    static constexpr size_t CACHE_LINE = 64;
+
+    struct Cell {
+        std::atomic<size_t> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    const size_t capacity_;
+    std::unique_ptr<Cell[]> cells;
+    alignas(CACHE_LINE) std::atomic<size_t> enqueue_pos;
+    alignas(CACHE_LINE) std::atomic<size_t> dequeue_pos;
+
+    /**
+     * Slot Claiming
+     * ------------
+     * Returns the claimed cell for producers, or nullptr when full
+     */
+    Cell* claim_for_push(size_t& pos) {
+        pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell* cell = &cells[pos % capacity_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    return cell;
+                }
+            } else if (diff < 0) {
+                return nullptr;  // Full: the cell still holds last lap's value
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param capacity: Maximum number of queued elements (> 0)
+     */
+    explicit MpmcRingBuffer(size_t capacity)
+        : capacity_(capacity), cells(new Cell[capacity]), enqueue_pos(0), dequeue_pos(0) {
+        if (capacity == 0) throw std::invalid_argument("Ring buffer capacity must be non-zero");
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer&) = delete;
+    MpmcRingBuffer& operator=(const MpmcRingBuffer&) = delete;
+
+    ~MpmcRingBuffer() {
+        while (try_pop()) {}
+    }
+
+    /**
+     * Enqueue
+     * ------
+     * Constructs the element in place if a cell is free.
+     * @return: false when the ring is full
+     */
+    template <typename... Args>
+    bool try_emplace(Args&&... args) {
+        size_t pos;
+        Cell* cell = claim_for_push(pos);
+        if (!cell) return false;
+        new (cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+    bool try_push(const T& value) { return try_emplace(value); }
+
+    /**
+     * Bulk Enqueue
+     * -----------
+     * Claims up to `count` consecutive free cells with one CAS and copies
+     * items into them in order.
+     * @return: Number of items pushed (0 when full)
+     */
+    size_t try_push_bulk(const T* items, size_t count) {
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        size_t claimed;
+        for (;;) {
+            claimed = 0;
+            while (claimed < count && claimed < capacity_ &&
+                   cells[(pos + claimed) % capacity_].sequence.load(std::memory_order_acquire) ==
+                       pos + claimed) {
+                ++claimed;
+            }
+            if (claimed == 0) {
+                size_t current = enqueue_pos.load(std::memory_order_relaxed);
+                if (current == pos) return 0;  // Full
+                pos = current;
+                continue;
+            }
+            if (enqueue_pos.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) break;
+        }
+
+        for (size_t i = 0; i < claimed; ++i) {
+            Cell& cell = cells[(pos + i) % capacity_];
+            new (cell.storage) T(items[i]);
+            cell.sequence.store(pos + i + 1, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    /**
+     * Dequeue
+     * ------
+     * @return: The oldest element, or std::nullopt when empty
+     */
+    std::optional<T> try_pop() {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell* cell = &cells[pos % capacity_];
+            size_t seq = cell->sequence.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    std::optional<T> result(std::move(*cell->value()));
+                    cell->value()->~T();
+                    cell->sequence.store(pos + capacity_, std::memory_order_release);
+                    return result;
+                }
+            } else if (diff < 0) {
+                return std::nullopt;  // Empty: producer has not published yet
+            } else {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * Bulk Dequeue
+     * -----------
+     * Claims up to `max` consecutive published cells with one CAS and moves
+     * them, oldest first, through the output iterator.
+     * @return: Number of elements popped (0 when empty)
+     */
+    template <typename OutputIt>
+    size_t try_pop_bulk(OutputIt out, size_t max) {
+        size_t pos = dequeue_pos.load(std::memory_order_relaxed);
+        size_t claimed;
+        for (;;) {
+            claimed = 0;
+            while (claimed < max && claimed < capacity_ &&
+                   cells[(pos + claimed) % capacity_].sequence.load(std::memory_order_acquire) ==
+                       pos + claimed + 1) {
+                ++claimed;
+            }
+            if (claimed == 0) {
+                size_t current = dequeue_pos.load(std::memory_order_relaxed);
+                if (current == pos) return 0;  // Empty
+                pos = current;
+                continue;
+            }
+            if (dequeue_pos.compare_exchange_weak(pos, pos + claimed, std::memory_order_relaxed)) break;
+        }
+
+        for (size_t i = 0; i < claimed; ++i) {
+            Cell& cell = cells[(pos + i) % capacity_];
+            *out++ = std::move(*cell.value());
+            cell.value()->~T();
+            cell.sequence.store(pos + i + capacity_, std::memory_order_release);
+        }
+        return claimed;
+    }
+
+    /**
+     * Occupancy Queries
+     * ----------------
+     * Snapshots only; may be stale by the time the caller acts on them
+     */
+    size_t size() const {
+        size_t head = dequeue_pos.load(std::memory_order_acquire);
+        size_t tail = enqueue_pos.load(std::memory_order_acquire);
+        return tail > head ? (tail - head > capacity_ ? capacity_ : tail - head) : 0;
+    }
+
+    bool empty() const { return size() == 0; }
+    size_t capacity() const { return capacity_; }
+};
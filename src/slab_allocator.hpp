@@ -0,0 +1,234 @@
+/*******************************************************************************
+ * Slab Allocator Implementation
+ * ---------------------------
+ * Fixed-size object caches layered on top of MemoryPool, modelled on the
+ * kernel slab/SLUB allocators:
+ *
+ * Key OS Memory Management Concepts Demonstrated:
+ * 1. Object Caching
+ *    - One cache per object size (like kmem_cache)
+ *    - Slabs carved from larger pool pages
+ *    - Free objects reused instead of returned to the page allocator
+ *
+ * 2. Metadata Elimination
+ *    - Intrusive free list stored inside free slots
+ *    - Zero per-object header
+ *    - Slot address alone identifies the object
+ *
+ * 3. Container Integration
+ *    - STL-compatible allocator adapter
+ *    - Fallback to MemoryPool for oversized requests
+ *
+ * Implementation Notes:
+ * - Allocation: O(1) pop from the free list (amortized page refill)
+ * - Deallocation: O(1) push onto the free list
+ * - Pages are only returned to MemoryPool when the slab is destroyed
+ * - Not synchronized; use one slab per thread or guard externally
+ *
+ * Slab Layout:
+ * +-------------------------------------------+
+ * | Pool Page                                 |
+ * |  +--------+--------+--------+--------+    |
+ * |  | Slot 0 | Slot 1 | Slot 2 |  ...   |    |
+ * |  +--------+--------+--------+--------+    |
+ * |      |                 ^                  |
+ * |      +--- next free ---+                  |
+ * +-------------------------------------------+
+ *
+ * Error Handling:
+ * - Pool exhausted: std::bad_alloc from MemoryPool
+ * - Null free: Silent return
+ ******************************************************************************/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <iostream>
+#include "memory_pool.hpp"
+
+/**
+ * SlabAllocator Class
+ * ==================
+ * Serves objects of at most Size bytes, aligned to Align, from pages
+ * obtained from a MemoryPool.
+ *
+ * @tparam Size:  Largest object size served by this cache
+ * @tparam Align: Slot alignment (power of two)
+ */
+template <size_t Size, size_t Align = alignof(std::max_align_t)>
+class SlabAllocator {
+    static_assert(Size > 0, "Slab object size must be non-zero");
+    static_assert(Align > 0 && (Align & (Align - 1)) == 0, "Slab alignment must be a power of two");
+
+    /**
+     * Free Slot Link
+     * -------------
+     * Overlays the first bytes of every free slot
+     */
+    struct FreeSlot {
+        FreeSlot* next;
+    };
+
+    static constexpr size_t raw_slot = Size > sizeof(FreeSlot) ? Size : sizeof(FreeSlot);
+    static constexpr size_t slot_align = Align > alignof(FreeSlot) ? Align : alignof(FreeSlot);
+
+public:
+    static constexpr size_t SLOT_SIZE = (raw_slot + slot_align - 1) & ~(slot_align - 1);
+    static constexpr size_t DEFAULT_SLOTS_PER_PAGE = 64;
+
+private:
+    MemoryPool& pool;                   // Backing page allocator
+    size_t slots_per_page;              // Slots carved from each page
+    FreeSlot* free_list;                // Head of intrusive free list
+    std::vector<void*> pages;           // Pages owned by this slab
+    size_t in_use;                      // Slots currently handed out
+
+    /**
+     * Page Refill
+     * ----------
+     * Takes one slot-aligned page from the pool and threads all its slots
+     * onto the free list.
+     */
+    void grow() {
+        void* page = pool.allocate(slots_per_page * SLOT_SIZE, slot_align);
+        pages.push_back(page);
+
+        char* first = static_cast<char*>(page);
+
+        // Thread slots in reverse so allocation walks the page forwards
+        for (size_t i = slots_per_page; i-- > 0;) {
+            FreeSlot* slot = reinterpret_cast<FreeSlot*>(first + i * SLOT_SIZE);
+            slot->next = free_list;
+            free_list = slot;
+        }
+    }
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param backing: Pool that supplies slab pages
+     * @param slots: Number of slots per page
+     */
+    explicit SlabAllocator(MemoryPool& backing, size_t slots = DEFAULT_SLOTS_PER_PAGE)
+        : pool(backing), slots_per_page(slots ? slots : 1), free_list(nullptr), in_use(0) {}
+
+    SlabAllocator(const SlabAllocator&) = delete;
+    SlabAllocator& operator=(const SlabAllocator&) = delete;
+
+    /**
+     * Destructor: Returns every page to the pool
+     */
+    ~SlabAllocator() {
+        for (void* page : pages) pool.deallocate(page);
+    }
+
+    /**
+     * Slot Allocation
+     * --------------
+     * @return: Pointer to an uninitialized slot of SLOT_SIZE bytes
+     * @throws: std::bad_alloc if the pool cannot supply a new page
+     */
+    void* allocate() {
+        if (!free_list) grow();
+        FreeSlot* slot = free_list;
+        free_list = slot->next;
+        ++in_use;
+        return slot;
+    }
+
+    /**
+     * Slot Deallocation
+     * ----------------
+     * @param ptr: Slot previously returned by allocate()
+     */
+    void deallocate(void* ptr) {
+        if (!ptr) return;
+        FreeSlot* slot = static_cast<FreeSlot*>(ptr);
+        slot->next = free_list;
+        free_list = slot;
+        --in_use;
+    }
+
+    /**
+     * Accessors
+     * --------
+     */
+    MemoryPool& backing_pool() const { return pool; }
+    size_t slots_in_use() const { return in_use; }
+    size_t page_count() const { return pages.size(); }
+    size_t capacity() const { return pages.size() * slots_per_page; }
+
+    /**
+     * Statistics Display
+     * -----------------
+     * Prints slot geometry and occupancy to the console.
+     */
+    void print_stats() const {
+        std::cout << "Slab Allocator Stats:\n"
+                  << "Slot Size: " << SLOT_SIZE << " bytes (align " << slot_align << ")\n"
+                  << "Pages: " << pages.size() << " x " << slots_per_page << " slots\n"
+                  << "Slots In Use: " << in_use << "/" << capacity() << "\n";
+    }
+};
+
+/**
+ * SlabStlAllocator Class
+ * =====================
+ * Standard allocator adapter so containers can draw from a slab. Requests
+ * that fit one slot (single nodes, small buffers) come from the slab; larger
+ * ones, such as a growing std::vector, fall back to the slab's MemoryPool.
+ *
+ * Usage:
+ *   SlabAllocator<64> slab(pool);
+ *   std::vector<int, SlabStlAllocator<int, 64>> values{SlabStlAllocator<int, 64>(slab)};
+ *   std::queue<int, std::deque<int, SlabStlAllocator<int, 512>>> q(...);
+ */
+template <typename T, size_t Size, size_t Align = alignof(std::max_align_t)>
+class SlabStlAllocator {
+public:
+    using value_type = T;
+    using slab_type = SlabAllocator<Size, Align>;
+
+    template <typename U>
+    struct rebind {
+        using other = SlabStlAllocator<U, Size, Align>;
+    };
+
+    explicit SlabStlAllocator(slab_type& slab) noexcept : slab(&slab) {}
+
+    template <typename U>
+    SlabStlAllocator(const SlabStlAllocator<U, Size, Align>& other) noexcept : slab(other.slab) {}
+
+    T* allocate(size_t n) {
+        if (n > SIZE_MAX / sizeof(T)) throw std::bad_alloc();
+        if (fits_slot(n)) return static_cast<T*>(slab->allocate());
+        return static_cast<T*>(slab->backing_pool().allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* ptr, size_t n) noexcept {
+        if (fits_slot(n)) slab->deallocate(ptr);
+        else slab->backing_pool().deallocate(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const SlabStlAllocator<U, Size, Align>& other) const noexcept {
+        return slab == other.slab;
+    }
+
+    template <typename U>
+    bool operator!=(const SlabStlAllocator<U, Size, Align>& other) const noexcept {
+        return slab != other.slab;
+    }
+
+private:
+    template <typename, size_t, size_t> friend class SlabStlAllocator;
+
+    static bool fits_slot(size_t n) noexcept {
+        return n * sizeof(T) <= slab_type::SLOT_SIZE && alignof(T) <= Align;
+    }
+
+    slab_type* slab;
+};
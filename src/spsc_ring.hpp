@@ -0,0 +1,107 @@
+/*******************************************************************************
+ * Single-Producer Single-Consumer Ring Buffer
+ * -----------------------------------------
+ * Wait-free bounded queue for exactly one producer thread and one consumer
+ * thread, used for per-thread log buffers:
+ *
+ * I. Concurrency Concepts Demonstrated:
+ * 1. Wait-Free Progress
+ *    - No CAS: each index has a single writer, so a release store suffices
+ *
+ * 2. In-Place Access
+ *    - Producer fills the slots returned by back() and publishes with push()
+ *    - Consumer reads front() in place and releases it with pop()
+ *
+ * 3. Cached Indices
+ *    - Each side keeps a private copy of the other side's index and only
+ *      re-reads the shared one when the copy says full/empty, so the hot
+ *      path touches only its own cache line
+ *
+ * Implementation Notes:
+ * - Indices grow monotonically; slots are indexed pos % capacity
+ * - Head and tail live on separate cache lines to avoid false sharing
+ * - Slots are default-constructed once and reused, not destroyed per pop
+ ******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
+template <typename T>
+class SpscRingBuffer {
+    static constexpr size_t CACHE_LINE = 64;
+
+    const size_t capacity_;
+    std::unique_ptr<T[]> slots;
+    alignas(CACHE_LINE) std::atomic<size_t> head;  // Next slot to read (consumer-owned)
+    size_t cached_tail;                             // Consumer's view of tail
+    alignas(CACHE_LINE) std::atomic<size_t> tail;  // Next slot to write (producer-owned)
+    size_t cached_head;                             // Producer's view of head
+
+public:
+    /**
+     * Constructor
+     * ----------
+     * @param capacity: Number of slots (> 0)
+     */
+    explicit SpscRingBuffer(size_t capacity)
+        : capacity_(capacity), slots(new T[capacity]), head(0), cached_tail(0), tail(0), cached_head(0) {
+        if (capacity == 0) throw std::invalid_argument("Ring buffer capacity must be non-zero");
+    }
+
+    SpscRingBuffer(const SpscRingBuffer&) = delete;
+    SpscRingBuffer& operator=(const SpscRingBuffer&) = delete;
+
+    /**
+     * Producer Side
+     * ------------
+     * free_slots() re-reads the consumer's index only when the cached view
+     * shows fewer than `needed` free slots; the consumer can only add space,
+     * so a result >= needed is always safe to act on
+     */
+    size_t free_slots(size_t needed = 1) {
+        size_t pos = tail.load(std::memory_order_relaxed);
+        if (capacity_ - (pos - cached_head) < needed) cached_head = head.load(std::memory_order_acquire);
+        return capacity_ - (pos - cached_head);
+    }
+
+    T* back(size_t offset = 0) {
+        return free_slots(offset + 1) > offset
+            ? &slots[(tail.load(std::memory_order_relaxed) + offset) % capacity_] : nullptr;
+    }
+
+    // Publishes `count` filled slots at once, so the consumer sees all or none
+    void push(size_t count = 1) {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /**
+     * Consumer Side
+     * ------------
+     * @return: The oldest published slot, or nullptr when empty
+     */
+    const T* front() {
+        size_t pos = head.load(std::memory_order_relaxed);
+        if (pos == cached_tail) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            if (pos == cached_tail) return nullptr;
+        }
+        return &slots[pos % capacity_];
+    }
+
+    void pop() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * Position Queries
+     * ---------------
+     * Monotonic counts of slots pushed and popped; safe from any thread
+     */
+    size_t pushed() const { return tail.load(std::memory_order_acquire); }
+    size_t popped() const { return head.load(std::memory_order_acquire); }
+    bool empty() const { return popped() == pushed(); }
+    size_t capacity() const { return capacity_; }
+};
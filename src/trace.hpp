@@ -0,0 +1,238 @@
+/*******************************************************************************
+ * Workload Trace Record and Replay
+ * -------------------------------
+ * Captures command streams (like blktrace captures block I/O) and plays
+ * them back against the CLI for throughput and latency runs:
+ *
+ * I. Concepts Demonstrated:
+ * 1. Trace Capture
+ *    - Each event is timestamped relative to the start of recording and
+ *      tagged with the stream (session) that issued it
+ *
+ * 2. Streaming Replay
+ *    - The trace is memory-mapped and parsed in place; nothing is loaded
+ *      into memory up front, so traces may be larger than RAM
+ *
+ * 3. Parallel Replay
+ *    - Streams are spread over replay threads (stream % threads), so the
+ *      events of one stream keep their order on one thread
+ *
+ * 4. Pacing
+ *    - FAST issues events back to back (throughput)
+ *    - TIMED sleeps until each event's offset from the replay start
+ *      (latency); lateness is reported as max_lag
+ *
+ * Trace Format (text, one event per line):
+ *   <microseconds> <stream> <command ...>
+ *   0 0 allocate 1024 @1
+ *   140 0 submit read 512
+ *   385 0 free @1
+ * Lines starting with '#' are comments. Allocations are named by "@label"
+ * so a free refers to the same block however addresses differ between runs.
+ *
+ * Error Handling:
+ * - Unopenable file: std::system_error
+ * - Malformed line: skipped and counted
+ ******************************************************************************/
+
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Trace Recorder
+ * -------------
+ * Appends events through a buffered stdio stream; thread-safe
+ */
+class TraceRecorder {
+    std::mutex mutex;                           // Serializes appends
+    std::FILE* file = nullptr;                  // Open trace, or nullptr
+    std::chrono::steady_clock::time_point start;  // Timestamp origin
+
+public:
+    TraceRecorder() = default;
+    TraceRecorder(const TraceRecorder&) = delete;
+    TraceRecorder& operator=(const TraceRecorder&) = delete;
+
+    ~TraceRecorder() {
+        stop();
+    }
+
+    /**
+     * @throws std::system_error if the file cannot be created
+     */
+    void start_recording(const std::string& path) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) std::fclose(file);
+        file = std::fopen(path.c_str(), "w");
+        if (!file) throw std::system_error(errno, std::generic_category(), "open " + path);
+        std::fputs("# kernel-sim trace v1: <microseconds> <stream> <command>\n", file);
+        start = std::chrono::steady_clock::now();
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (file) std::fclose(file);
+        file = nullptr;
+    }
+
+    bool recording() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return file != nullptr;
+    }
+
+    void record(uint32_t stream, std::string_view command) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!file) return;
+        auto offset = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+        std::fprintf(file, "%lld %u %.*s\n", static_cast<long long>(offset), stream,
+                     static_cast<int>(command.size()), command.data());
+    }
+};
+
+/**
+ * Trace Replayer
+ * -------------
+ * Executes a recorded trace through a caller-supplied executor:
+ *   executor(size_t thread, uint64_t stream, const std::string& command)
+ * Calls with the same `thread` never overlap, so per-thread state needs
+ * no locking
+ */
+class TraceReplayer {
+public:
+    enum class Mode {
+        FAST,    // As fast as possible
+        TIMED    // Honour recorded inter-event gaps
+    };
+
+    struct Stats {
+        size_t events = 0;          // Commands executed
+        size_t malformed = 0;       // Lines skipped
+        double seconds = 0;         // Wall time of the replay
+        double max_lag_us = 0;      // TIMED: worst lateness vs. the trace
+    };
+
+private:
+    const char* data = nullptr;  // Read-only mapping of the trace
+    size_t size = 0;             // Mapped bytes
+
+    static bool parse_number(std::string_view& line, uint64_t& value) {
+        size_t i = 0;
+        value = 0;
+        while (i < line.size() && line[i] >= '0' && line[i] <= '9') {
+            value = value * 10 + static_cast<uint64_t>(line[i] - '0');
+            ++i;
+        }
+        if (i == 0 || i == line.size() || line[i] != ' ') return false;
+        line.remove_prefix(i + 1);
+        return true;
+    }
+
+    template <typename Executor>
+    void replay_share(size_t thread, size_t threads, Mode mode,
+                      std::chrono::steady_clock::time_point start,
+                      Executor& executor, Stats& stats) const {
+        std::string command;
+        std::string_view rest(data, size);
+        while (!rest.empty()) {
+            size_t newline = rest.find('\n');
+            std::string_view line = rest.substr(0, newline);
+            rest.remove_prefix(newline == std::string_view::npos ? rest.size() : newline + 1);
+            if (line.empty() || line[0] == '#') continue;
+
+            uint64_t offset_us, stream;
+            if (!parse_number(line, offset_us) || !parse_number(line, stream) || line.empty()) {
+                if (thread == 0) ++stats.malformed;
+                continue;
+            }
+            if (stream % threads != thread) continue;
+
+            if (mode == Mode::TIMED) {
+                auto due = start + std::chrono::microseconds(offset_us);
+                std::this_thread::sleep_until(due);
+                double lag = std::chrono::duration<double, std::micro>(
+                    std::chrono::steady_clock::now() - due).count();
+                if (lag > stats.max_lag_us) stats.max_lag_us = lag;
+            }
+            command.assign(line.data(), line.size());
+            executor(thread, stream, command);
+            ++stats.events;
+        }
+    }
+
+public:
+    /**
+     * @throws std::system_error if the trace cannot be opened or mapped
+     */
+    explicit TraceReplayer(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) throw std::system_error(errno, std::generic_category(), "open " + path);
+        struct stat info;
+        if (::fstat(fd, &info) != 0) {
+            int error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), "stat " + path);
+        }
+        size = static_cast<size_t>(info.st_size);
+        if (size > 0) {
+            void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED) {
+                int error = errno;
+                ::close(fd);
+                throw std::system_error(error, std::generic_category(), "mmap " + path);
+            }
+            ::madvise(mapping, size, MADV_SEQUENTIAL);
+            data = static_cast<const char*>(mapping);
+        }
+        ::close(fd);
+    }
+
+    ~TraceReplayer() {
+        if (data) ::munmap(const_cast<char*>(data), size);
+    }
+
+    TraceReplayer(const TraceReplayer&) = delete;
+    TraceReplayer& operator=(const TraceReplayer&) = delete;
+
+    /**
+     * Replay
+     * -----
+     * Runs `threads` replay threads (the calling thread included) and
+     * returns once every event has been executed.
+     * @return: Totals across all threads
+     */
+    template <typename Executor>
+    Stats replay(Executor executor, Mode mode = Mode::FAST, size_t threads = 1) const {
+        if (threads == 0) threads = 1;
+        std::vector<Stats> partial(threads);
+        auto start = std::chrono::steady_clock::now();
+
+        std::vector<std::thread> helpers;
+        for (size_t t = 1; t < threads; ++t) {
+            helpers.emplace_back([&, t] { replay_share(t, threads, mode, start, executor, partial[t]); });
+        }
+        replay_share(0, threads, mode, start, executor, partial[0]);
+        for (auto& helper : helpers) helper.join();
+
+        Stats total;
+        for (const Stats& share : partial) {
+            total.events += share.events;
+            total.malformed += share.malformed;
+            if (share.max_lag_us > total.max_lag_us) total.max_lag_us = share.max_lag_us;
+        }
+        total.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return total;
+    }
+};
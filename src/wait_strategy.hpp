@@ -0,0 +1,108 @@
+/*******************************************************************************
+ * Adaptive Wait Strategy
+ * --------------------
+ * Spin-then-park waiting for lock-free queues, modelled on kernel adaptive
+ * mutexes and futex-based event counts:
+ *
+ * I. Concepts Demonstrated:
+ * 1. Adaptive Waiting
+ *    - Busy-spin with a CPU pause hint while work is likely imminent
+ *    - Yield the time slice for a while longer
+ *    - Park on a condition variable only when truly idle
+ *
+ * 2. Wakeup Avoidance
+ *    - Producers check an atomic sleeper count before signalling
+ *    - A busy consumer never costs its producers a futex wake
+ *
+ * 3. Lost-Wakeup Prevention
+ *    - Sleeper registration and the producer's publish are both ordered by
+ *      seq_cst fences (Dekker-style), and the final readiness check happens
+ *      under the park mutex
+ *
+ * Usage:
+ *   producer:  queue.try_push(x); waiter.notify_one();
+ *   consumer:  waiter.wait([&] { return !queue.empty() || stopping; });
+ ******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+
+/**
+ * CPU Relax Hint
+ * -------------
+ * Tells the core we are spinning (saves power, frees SMT resources)
+ */
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+class AdaptiveWaiter {
+public:
+    static constexpr int DEFAULT_SPINS = 256;    // Pause-loop iterations
+    static constexpr int DEFAULT_YIELDS = 16;    // sched_yield rounds
+
+private:
+    std::atomic<int> sleepers;
+    std::mutex mutex;
+    std::condition_variable cv;
+    int spin_limit;
+    int yield_limit;
+
+public:
+    explicit AdaptiveWaiter(int spins = DEFAULT_SPINS, int yields = DEFAULT_YIELDS)
+        : sleepers(0), spin_limit(spins), yield_limit(yields) {}
+
+    /**
+     * Wait Until Ready
+     * ---------------
+     * Returns once ready() is true; ready must become true only after the
+     * state change has been published and notify_*() called.
+     */
+    template <typename Predicate>
+    void wait(Predicate ready) {
+        for (int i = 0; i < spin_limit; ++i) {
+            if (ready()) return;
+            cpu_relax();
+        }
+        for (int i = 0; i < yield_limit; ++i) {
+            if (ready()) return;
+            std::this_thread::yield();
+        }
+
+        sleepers.fetch_add(1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cv.wait(lock, ready);
+        }
+        sleepers.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * Signalling
+     * ---------
+     * Cheap when nobody is parked: one fence and one atomic load
+     */
+    void notify_one() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_one();
+    }
+
+    void notify_all() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleepers.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(mutex);
+        cv.notify_all();
+    }
+
+    int parked() const { return sleepers.load(std::memory_order_relaxed); }
+};
@@ -0,0 +1,230 @@
+/*******************************************************************************
+ * Binary Log Decoder
+ * -----------------
+ * Turns a BinaryLog file (see src/binary_log.hpp) back into the text form
+ * the Logger prints:
+ *
+ *   [YYYY-MM-DD HH:MM:SS] [LEVEL] message
+ *
+ * Usage:
+ *   g++ -std=c++17 -O2 -pthread -Isrc tools/log_decode.cpp -o log_decode
+ *   ./log_decode trace.blog [--micros]
+ *
+ * --micros appends microseconds to the timestamp for high-rate traces.
+ *
+ * Error Handling:
+ * - Unreadable file or bad magic: message on stderr, exit status 1
+ * - Truncated or corrupt record: decoding stops there, exit status 2
+ ******************************************************************************/
+
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <unordered_map>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "binary_log.hpp"
+
+namespace {
+
+const char* level_name(uint8_t level) {
+    switch (static_cast<Logger::Level>(level)) {
+        case Logger::Level::DEBUG: return "DEBUG";
+        case Logger::Level::INFO: return "INFO";
+        case Logger::Level::WARNING: return "WARNING";
+        case Logger::Level::ERROR: return "ERROR";
+        default: return "UNKNOWN";
+    }
+}
+
+/**
+ * Argument Cursor
+ * --------------
+ * Renders one encoded argument as Logger's formatter would
+ */
+bool render_arg(const char*& in, const char* end, std::string& out) {
+    if (in >= end) return false;
+    auto type = static_cast<BinaryLog::ArgType>(*in++);
+    char buffer[64];
+    auto fixed = [&](void* value, size_t size) {
+        if (static_cast<size_t>(end - in) < size) return false;
+        std::memcpy(value, in, size);
+        in += size;
+        return true;
+    };
+
+    switch (type) {
+        case BinaryLog::INT64: {
+            int64_t value;
+            if (!fixed(&value, sizeof(value))) return false;
+            std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(value));
+            break;
+        }
+        case BinaryLog::UINT64: {
+            uint64_t value;
+            if (!fixed(&value, sizeof(value))) return false;
+            std::snprintf(buffer, sizeof(buffer), "%llu", static_cast<unsigned long long>(value));
+            break;
+        }
+        case BinaryLog::DOUBLE: {
+            double value;
+            if (!fixed(&value, sizeof(value))) return false;
+            auto result = std::to_chars(buffer, buffer + sizeof(buffer) - 1, value);
+            *result.ptr = '\0';
+            break;
+        }
+        case BinaryLog::POINTER: {
+            uint64_t value;
+            if (!fixed(&value, sizeof(value))) return false;
+            std::snprintf(buffer, sizeof(buffer), "0x%llx", static_cast<unsigned long long>(value));
+            break;
+        }
+        case BinaryLog::BOOL: {
+            uint8_t value;
+            if (!fixed(&value, sizeof(value))) return false;
+            out += value ? "true" : "false";
+            return true;
+        }
+        case BinaryLog::CHAR: {
+            char value;
+            if (!fixed(&value, sizeof(value))) return false;
+            out += value;
+            return true;
+        }
+        case BinaryLog::STRING: {
+            uint16_t length;
+            if (!fixed(&length, sizeof(length)) || static_cast<size_t>(end - in) < length) return false;
+            out.append(in, length);
+            in += length;
+            return true;
+        }
+        default:
+            return false;
+    }
+    out += buffer;
+    return true;
+}
+
+/**
+ * Message Expansion
+ * ----------------
+ * Same rules as Logger::logf: "{}" takes the next argument, "{{"/"}}" are
+ * literal braces, surplus "{}" are kept verbatim
+ */
+bool render_message(const std::string& format, const char* in, const char* end,
+                    uint16_t arg_count, std::string& out) {
+    uint16_t used = 0;
+    for (size_t i = 0; i < format.size(); ++i) {
+        char c = format[i];
+        char next = i + 1 < format.size() ? format[i + 1] : '\0';
+        if ((c == '{' || c == '}') && next == c) {
+            out += c;
+            ++i;
+        } else if (c == '{' && next == '}' && used < arg_count) {
+            if (!render_arg(in, end, out)) return false;
+            ++used;
+            ++i;
+        } else {
+            out += c;
+        }
+    }
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::fprintf(stderr, "Usage: %s <file> [--micros]\n", argv[0]);
+        return 1;
+    }
+    bool micros = argc > 2 && std::strcmp(argv[2], "--micros") == 0;
+
+    int fd = ::open(argv[1], O_RDONLY | O_CLOEXEC);
+    struct stat info;
+    if (fd < 0 || ::fstat(fd, &info) != 0) {
+        std::perror(argv[1]);
+        return 1;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    if (size < sizeof(BinaryLog::FileHeader)) {
+        std::fprintf(stderr, "%s: not a binary log\n", argv[1]);
+        return 1;
+    }
+    void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapping == MAP_FAILED) {
+        std::perror("mmap");
+        return 1;
+    }
+    const char* data = static_cast<const char*>(mapping);
+
+    BinaryLog::FileHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, BinaryLog::MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BinaryLog::VERSION || header.ticks_per_second <= 0) {
+        std::fprintf(stderr, "%s: not a binary log\n", argv[1]);
+        return 1;
+    }
+
+    std::unordered_map<uint32_t, std::string> formats;
+    std::string line;
+    int status = 0;
+    size_t offset = BinaryLog::align_record(header.header_size);
+    while (offset + sizeof(BinaryLog::RecordHeader) <= size) {
+        BinaryLog::RecordHeader record;
+        std::memcpy(&record, data + offset, sizeof(record));
+        if (record.size == 0) break;  // Unwritten tail
+        if (record.size < sizeof(record) || record.size > size - offset) {
+            std::fprintf(stderr, "corrupt record at offset %zu\n", offset);
+            status = 2;
+            break;
+        }
+        const char* payload = data + offset + sizeof(record);
+        const char* end = data + offset + record.size;
+
+        if (record.type == BinaryLog::FORMAT) {
+            // Padding is zero bytes; the text itself never contains NUL
+            formats[record.format_id] = std::string(payload, strnlen(payload, end - payload));
+        } else if (record.type == BinaryLog::EVENT) {
+            int64_t delta = record.ticks - header.steady_origin;
+            int64_t since_open = delta / header.ticks_per_second * 1000000000 +
+                                 delta % header.ticks_per_second * 1000000000 / header.ticks_per_second;
+            int64_t wall_ns = header.wall_origin_ns + since_open;
+            std::time_t seconds = static_cast<std::time_t>(wall_ns / 1000000000);
+            std::tm tm;
+            localtime_r(&seconds, &tm);
+            char stamp[48];
+            size_t length = std::strftime(stamp, sizeof(stamp), "%Y-%m-%d %H:%M:%S", &tm);
+            if (micros) {
+                std::snprintf(stamp + length, sizeof(stamp) - length, ".%06lld",
+                              static_cast<long long>((wall_ns % 1000000000) / 1000));
+            }
+
+            line.clear();
+            line += '[';
+            line += stamp;
+            line += "] [";
+            line += level_name(record.level);
+            line += "] ";
+            auto format = formats.find(record.format_id);
+            if (format == formats.end()) {
+                line += "<unknown format " + std::to_string(record.format_id) + ">";
+            } else if (!render_message(format->second, payload, end, record.arg_count, line)) {
+                std::fprintf(stderr, "corrupt arguments at offset %zu\n", offset);
+                status = 2;
+                break;
+            }
+            line += '\n';
+            std::fwrite(line.data(), 1, line.size(), stdout);
+        }
+        offset += record.size;
+    }
+
+    ::munmap(mapping, size);
+    ::close(fd);
+    return status;
+}